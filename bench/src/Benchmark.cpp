@@ -0,0 +1,136 @@
+#include "Benchmark.h"
+
+#include <iomanip>
+#include <utility>
+
+BenchmarkContext::BenchmarkContext(std::uint64_t seed,
+                                   std::chrono::duration<double> minDuration,
+                                   std::size_t repetitions)
+    : m_randomState(seed),
+      m_minDuration(minDuration),
+      m_repetitions(std::max<std::size_t>(repetitions, 1))
+{
+}
+
+double BenchmarkContext::random(double min, double max)
+{
+    // SplitMix64
+    m_randomState += 0x9E3779B97F4A7C15ull;
+
+    std::uint64_t value = m_randomState;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    value ^= value >> 31;
+
+    return min + (max - min) * static_cast<double>(value >> 11) * 0x1.0p-53;
+}
+
+void BenchmarkContext::setCounter(const std::string& name, double value)
+{
+    m_result.counters.emplace_back(name, value);
+}
+
+const BenchmarkResult& BenchmarkContext::getResult() const
+{
+    return m_result;
+}
+
+void Benchmarks::add(std::string name, bool countsRays, Function function)
+{
+    m_benchmarks.push_back({std::move(name), countsRays, std::move(function)});
+}
+
+std::vector<BenchmarkResult> Benchmarks::run(const std::string& filter,
+                                             std::uint64_t seed,
+                                             std::chrono::duration<double> minDuration,
+                                             std::size_t repetitions,
+                                             std::ostream& log) const
+{
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& benchmark : m_benchmarks)
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        BenchmarkContext context(seed, minDuration, repetitions);
+        benchmark.function(context);
+
+        BenchmarkResult result = context.getResult();
+        result.name = benchmark.name;
+        result.countsRays = benchmark.countsRays;
+        result.peakMemory = getPeakMemory();
+
+        log << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << result.nsPerCall << " ns/call";
+        if (result.countsRays)
+            log << std::setw(14) << std::setprecision(0) << 1e9 / result.nsPerCall << " rays/s";
+        log << std::endl;
+
+        for (const auto& [counter, value] : result.counters)
+        {
+            log << "    " << std::left << std::setw(36) << counter << std::right << std::setprecision(2)
+                << std::setw(12) << value << '\n';
+        }
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+namespace
+{
+    std::string quote(const std::string& text)
+    {
+        std::string res = "\"";
+        for (char character : text)
+        {
+            if (character == '"' || character == '\\')
+                res += '\\';
+            res += character;
+        }
+
+        return res + "\"";
+    }
+} // namespace
+
+void Benchmarks::writeJson(std::ostream& stream, std::uint64_t seed, const std::vector<BenchmarkResult>& results)
+{
+    stream << std::setprecision(17) << "{\n";
+    stream << "  \"seed\": " << seed << ",\n";
+    stream << "  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const auto& result = results[i];
+
+        stream << (i == 0 ? "\n" : ",\n") << "    {\n";
+        stream << "      \"name\": " << quote(result.name) << ",\n";
+        stream << "      \"iterations\": " << result.iterations << ",\n";
+        stream << "      \"repetitions\": " << result.repetitions << ",\n";
+        stream << "      \"ns_per_call\": " << result.nsPerCall << ",\n";
+        stream << "      \"min_ns_per_call\": " << result.minNsPerCall << ",\n";
+        stream << "      \"calls_per_second\": " << 1e9 / result.nsPerCall << ",\n";
+        if (result.countsRays)
+            stream << "      \"rays_per_second\": " << 1e9 / result.nsPerCall << ",\n";
+        stream << "      \"checksum\": " << result.checksum << ",\n";
+        stream << "      \"peak_rss_bytes\": " << result.peakMemory;
+
+        if (!result.counters.empty())
+        {
+            stream << ",\n      \"counters\": {";
+            for (std::size_t j = 0; j < result.counters.size(); j++)
+            {
+                stream << (j == 0 ? "\n" : ",\n") << "        " << quote(result.counters[j].first) << ": "
+                       << result.counters[j].second;
+            }
+            stream << "\n      }";
+        }
+
+        stream << "\n";
+        stream << "    }";
+    }
+
+    stream << "\n  ]\n}\n";
+}
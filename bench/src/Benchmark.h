@@ -0,0 +1,237 @@
+#ifndef H_RAYTRACING_BENCHMARK_H
+#define H_RAYTRACING_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct BenchmarkResult
+ * @brief The measures of a benchmark.
+ */
+struct BenchmarkResult
+{
+    std::string name;
+
+    /**
+     * True if a call is a ray (an intersection test or a traced ray).
+     */
+    bool countsRays = false;
+
+    /**
+     * The calls of each repetition.
+     */
+    std::size_t iterations = 0;
+    std::size_t repetitions = 0;
+
+    /**
+     * The median and the fastest of the repetitions.
+     */
+    double nsPerCall = 0.0;
+    double minNsPerCall = 0.0;
+
+    /**
+     * Sum of the values returned by the benchmarked function over the data, to check that the work didn't change.
+     */
+    double checksum = 0.0;
+
+    /**
+     * Peak memory usage of the process (resident set size) at the end of the benchmark, in bytes.
+     */
+    std::size_t peakMemory = 0;
+
+    /**
+     * Other measures given by the benchmark (name and value).
+     */
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+/**
+ * @class BenchmarkContext
+ * @brief Given to a benchmark to generate its data and measure its kernel.
+ *
+ * The random values don't depend on the standard library (no std::uniform_real_distribution), so the same seed gives
+ * the same data on every platform.
+ */
+class BenchmarkContext
+{
+public:
+    /**
+     * @brief Create a context.
+     *
+     * @param seed        The seed of the random values.
+     * @param minDuration The minimum duration of the measures (all the repetitions).
+     * @param repetitions The number of measures, the result is their median.
+     */
+    BenchmarkContext(std::uint64_t seed, std::chrono::duration<double> minDuration, std::size_t repetitions);
+
+    /**
+     * @brief Get a random number.
+     *
+     * @param min The minimum value.
+     * @param max The maximum value (excluded).
+     *
+     * @return Returns a number in [min;max[.
+     */
+    double random(double min = 0.0, double max = 1.0);
+
+    /**
+     * @brief Measure a function.
+     *
+     * The function is called with the index of a benchmark data (going through them again and again), and returns a
+     * value summed so that the call can't be optimized out. The checksum of the result is the sum of the values of a
+     * single pass over the data, so it only depends on the seed.
+     *
+     * @tparam Function A function taking a std::size_t and returning a value convertible to double.
+     *
+     * @param count    The number of benchmark data.
+     * @param function The function to measure.
+     */
+    template<typename Function>
+    void measure(std::size_t count, Function function)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Also warms the caches up
+        double checksum = 0.0;
+        for (std::size_t i = 0; i < count; i++)
+            checksum += static_cast<double>(function(i));
+
+        auto run = [&](std::size_t iterations) {
+            double sum = 0.0;
+
+            auto start = Clock::now();
+            for (std::size_t i = 0, index = 0; i < iterations; i++)
+            {
+                sum += static_cast<double>(function(index));
+                index = index + 1 == count ? 0 : index + 1;
+            }
+            std::chrono::duration<double> duration = Clock::now() - start;
+
+            m_sink = sum;
+
+            return duration.count();
+        };
+
+        // Find the number of calls of a repetition
+        double repetitionDuration = m_minDuration.count() / static_cast<double>(m_repetitions);
+
+        std::size_t iterations = count;
+        for (double duration = run(iterations); duration < repetitionDuration; duration = run(iterations))
+        {
+            double factor = duration > 0.0 ? 1.5 * repetitionDuration / duration : 10.0;
+            iterations = static_cast<std::size_t>(static_cast<double>(iterations) * std::clamp(factor, 1.5, 10.0));
+        }
+
+        std::vector<double> nsPerCall;
+        for (std::size_t i = 0; i < m_repetitions; i++)
+            nsPerCall.push_back(run(iterations) * 1e9 / static_cast<double>(iterations));
+
+        std::sort(nsPerCall.begin(), nsPerCall.end());
+
+        m_result.iterations = iterations;
+        m_result.repetitions = m_repetitions;
+        m_result.nsPerCall = nsPerCall[nsPerCall.size() / 2];
+        m_result.minNsPerCall = nsPerCall.front();
+        m_result.checksum = checksum;
+    }
+
+    /**
+     * @brief Add a measure to the result (like the number of rays of a render).
+     *
+     * @param name  The name of the measure.
+     * @param value The value.
+     */
+    void setCounter(const std::string& name, double value);
+
+    const BenchmarkResult& getResult() const;
+
+private:
+    std::uint64_t m_randomState;
+    std::chrono::duration<double> m_minDuration;
+    std::size_t m_repetitions;
+
+    BenchmarkResult m_result;
+
+    /**
+     * Written after each run so that the compiler keeps the calls.
+     */
+    volatile double m_sink = 0.0;
+};
+
+/**
+ * @class Benchmarks
+ * @brief The list of the benchmarks.
+ */
+class Benchmarks
+{
+public:
+    using Function = std::function<void(BenchmarkContext&)>;
+
+    /**
+     * @brief Add a benchmark.
+     *
+     * @param name       The name of the benchmark (the benchmarked function).
+     * @param countsRays True if each call is a ray.
+     * @param function   The benchmark, generating its data and calling BenchmarkContext::measure().
+     */
+    void add(std::string name, bool countsRays, Function function);
+
+    /**
+     * @brief Run the benchmarks.
+     *
+     * Every benchmark gets its own context with the same seed, so its data doesn't depend on the other ones.
+     *
+     * @param filter      Only run the benchmarks containing this string in their name (all if empty).
+     * @param seed        The seed of the random values.
+     * @param minDuration The minimum duration of each benchmark.
+     * @param repetitions The number of measures per benchmark.
+     * @param log         Stream where the progress is written.
+     *
+     * @return Returns the results.
+     */
+    std::vector<BenchmarkResult> run(const std::string& filter,
+                                     std::uint64_t seed,
+                                     std::chrono::duration<double> minDuration,
+                                     std::size_t repetitions,
+                                     std::ostream& log) const;
+
+    /**
+     * @brief Write results as JSON.
+     *
+     * @param stream  The output stream.
+     * @param seed    The seed used for the results.
+     * @param results The results.
+     */
+    static void writeJson(std::ostream& stream, std::uint64_t seed, const std::vector<BenchmarkResult>& results);
+
+private:
+    struct Benchmark
+    {
+        std::string name;
+        bool countsRays;
+        Function function;
+    };
+
+    std::vector<Benchmark> m_benchmarks;
+};
+
+void addObjectBenchmarks(Benchmarks& benchmarks);
+void addMatrixBenchmarks(Benchmarks& benchmarks);
+void addSceneBenchmarks(Benchmarks& benchmarks);
+void addRenderBenchmarks(Benchmarks& benchmarks);
+
+/**
+ * @brief Get the peak memory usage of the process.
+ *
+ * @return Returns the peak resident set size in bytes (0 if unknown).
+ */
+std::size_t getPeakMemory();
+
+#endif //H_RAYTRACING_BENCHMARK_H
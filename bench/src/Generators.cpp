@@ -0,0 +1,110 @@
+#include "Generators.h"
+
+#include <Utils/Exceptions.h>
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+} // namespace
+
+Vector3 randomDirection(BenchmarkContext& context)
+{
+    // Uniform on the sphere
+    double z = context.random(-1.0, 1.0);
+    double angle = context.random(0.0, 2.0 * PI);
+    double radius = std::sqrt(1.0 - z * z);
+
+    return Vector3(radius * std::cos(angle), radius * std::sin(angle), z);
+}
+
+std::vector<Ray> randomRays(BenchmarkContext& context,
+                            std::size_t count,
+                            const Vector3& originCenter,
+                            double originSize,
+                            const Vector3& target,
+                            double targetRadius)
+{
+    std::vector<Ray> rays;
+    rays.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Vector3 origin(originCenter.x() + context.random(-0.5, 0.5) * originSize,
+                       originCenter.y() + context.random(-0.5, 0.5) * originSize,
+                       originCenter.z() + context.random(-0.5, 0.5) * originSize);
+
+        Vector3 point = target + randomDirection(context) * (targetRadius * context.random());
+
+        rays.emplace_back(origin, (point - origin).normalize(), PRIMARY);
+    }
+
+    return rays;
+}
+
+std::string writeSphereMesh(const std::string& path, std::size_t rings, std::size_t segments)
+{
+    std::ofstream file(path);
+    if (!file)
+        throw Exception::Loader::CantOpenFile(path);
+
+    // Poles, then the vertices of the rings between them
+    file << "v 0 1 0\nv 0 -1 0\n";
+    for (std::size_t ring = 1; ring < rings; ring++)
+    {
+        double polar = PI * static_cast<double>(ring) / static_cast<double>(rings);
+        for (std::size_t segment = 0; segment < segments; segment++)
+        {
+            double azimuth = 2.0 * PI * static_cast<double>(segment) / static_cast<double>(segments);
+            file << "v " << std::sin(polar) * std::cos(azimuth) << ' ' << std::cos(polar) << ' '
+                 << std::sin(polar) * std::sin(azimuth) << '\n';
+        }
+    }
+
+    // 1-based OBJ index of a ring vertex
+    auto vertex = [&](std::size_t ring, std::size_t segment) { return 3 + (ring - 1) * segments + segment % segments; };
+
+    for (std::size_t segment = 0; segment < segments; segment++)
+    {
+        file << "f 1 " << vertex(1, segment + 1) << ' ' << vertex(1, segment) << '\n';
+        file << "f 2 " << vertex(rings - 1, segment) << ' ' << vertex(rings - 1, segment + 1) << '\n';
+
+        for (std::size_t ring = 1; ring + 1 < rings; ring++)
+        {
+            file << "f " << vertex(ring, segment) << ' ' << vertex(ring, segment + 1) << ' '
+                 << vertex(ring + 1, segment + 1) << ' ' << vertex(ring + 1, segment) << '\n';
+        }
+    }
+
+    return path;
+}
+
+TemporarySphereMesh::TemporarySphereMesh(std::size_t rings, std::size_t segments)
+{
+    // A new directory, the benchmarks of several processes don't share it
+    std::random_device random;
+    std::uniform_int_distribution<std::uint64_t> distribution;
+    do
+    {
+        std::string name = "raytracing_bench_" + std::to_string(distribution(random));
+        m_directory = std::filesystem::temp_directory_path() / name;
+    } while (!std::filesystem::create_directory(m_directory));
+
+    m_path = writeSphereMesh((m_directory / "sphere.obj").string(), rings, segments);
+}
+
+TemporarySphereMesh::~TemporarySphereMesh()
+{
+    std::error_code error;
+    std::filesystem::remove_all(m_directory, error);
+}
+
+const std::string& TemporarySphereMesh::getPath() const
+{
+    return m_path;
+}
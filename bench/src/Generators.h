@@ -0,0 +1,88 @@
+#ifndef H_RAYTRACING_GENERATORS_H
+#define H_RAYTRACING_GENERATORS_H
+
+#include "Benchmark.h"
+
+#include <Utils/Ray.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Get a random unit vector.
+ *
+ * @param context The benchmark context (for its random values).
+ *
+ * @return Returns the vector.
+ */
+Vector3 randomDirection(BenchmarkContext& context);
+
+/**
+ * @brief Get random rays starting from a box and going toward a sphere of targets.
+ *
+ * @param context      The benchmark context (for its random values).
+ * @param count        The number of rays.
+ * @param originCenter The center of the box of the origins.
+ * @param originSize   The size of the box of the origins.
+ * @param target       The center of the targets.
+ * @param targetRadius The radius of the sphere of the targets.
+ *
+ * @return Returns the rays.
+ */
+std::vector<Ray> randomRays(BenchmarkContext& context,
+                            std::size_t count,
+                            const Vector3& originCenter,
+                            double originSize,
+                            const Vector3& target,
+                            double targetRadius);
+
+/**
+ * @brief Write a UV sphere as an OBJ file.
+ *
+ * @param path     The path of the file.
+ * @param rings    The number of rings (from pole to pole).
+ * @param segments The number of segments (around the poles).
+ *
+ * @return Returns the path of the file.
+ */
+std::string writeSphereMesh(const std::string& path, std::size_t rings, std::size_t segments);
+
+/**
+ * @class TemporarySphereMesh
+ * @brief A UV sphere written as an OBJ file in a new temporary directory, removed with its cache files.
+ *
+ * Each benchmark run parses a new file: nothing left by the previous runs (mesh or cache) is loaded.
+ */
+class TemporarySphereMesh
+{
+public:
+    /**
+     * @brief Write the mesh.
+     *
+     * @param rings    The number of rings (from pole to pole).
+     * @param segments The number of segments (around the poles).
+     */
+    TemporarySphereMesh(std::size_t rings, std::size_t segments);
+
+    TemporarySphereMesh(const TemporarySphereMesh&) = delete;
+    TemporarySphereMesh& operator=(const TemporarySphereMesh&) = delete;
+
+    /**
+     * @brief Remove the directory of the mesh (the OBJ file and its cache files).
+     */
+    ~TemporarySphereMesh();
+
+    /**
+     * @brief Get the path of the OBJ file.
+     *
+     * @return Returns the path.
+     */
+    const std::string& getPath() const;
+
+private:
+    std::filesystem::path m_directory;
+    std::string m_path;
+};
+
+#endif //H_RAYTRACING_GENERATORS_H
@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    void printUsage(const char* program)
+    {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --filter <text>      Only run the benchmarks containing <text>\n"
+                  << "  --seed <n>           Seed of the benchmark data (default 1)\n"
+                  << "  --min-time <s>       Minimum duration of each benchmark in seconds (default 0.5)\n"
+                  << "  --repetitions <n>    Number of measures of each benchmark, the median is kept (default 5)\n"
+                  << "  --output <path>      Write the JSON results in a file instead of the standard output\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::uint64_t seed = 1;
+    double minTime = 0.5;
+    std::size_t repetitions = 5;
+    std::string output;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+
+            if (argument == "--help" || i + 1 >= argc)
+            {
+                printUsage(argv[0]);
+                return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+
+            std::string value = argv[++i];
+
+            if (argument == "--filter")
+                filter = value;
+            else if (argument == "--seed")
+                seed = std::stoull(value);
+            else if (argument == "--min-time")
+                minTime = std::stod(value);
+            else if (argument == "--repetitions")
+                repetitions = std::stoul(value);
+            else if (argument == "--output")
+                output = value;
+            else
+            {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+
+        Benchmarks benchmarks;
+        addObjectBenchmarks(benchmarks);
+        addMatrixBenchmarks(benchmarks);
+        addSceneBenchmarks(benchmarks);
+        addRenderBenchmarks(benchmarks);
+
+        auto results = benchmarks.run(filter, seed, std::chrono::duration<double>(minTime), repetitions, std::cerr);
+
+        if (output.empty())
+        {
+            Benchmarks::writeJson(std::cout, seed, results);
+        }
+        else
+        {
+            std::ofstream file(output);
+            Benchmarks::writeJson(file, seed, results);
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
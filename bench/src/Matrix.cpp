@@ -0,0 +1,50 @@
+#include "Benchmark.h"
+#include "Generators.h"
+
+#include <Utils/Matrix.h>
+
+namespace
+{
+    /**
+     * The number of vectors of each benchmark.
+     */
+    constexpr std::size_t VECTOR_COUNT = 4096;
+
+    std::vector<Vector3> randomVectors(BenchmarkContext& context)
+    {
+        std::vector<Vector3> vectors;
+        for (std::size_t i = 0; i < VECTOR_COUNT; i++)
+            vectors.push_back(randomDirection(context) * context.random(0.5, 10.0));
+
+        return vectors;
+    }
+} // namespace
+
+void addMatrixBenchmarks(Benchmarks& benchmarks)
+{
+    benchmarks.add("Matrix::normalize", false, [](BenchmarkContext& context) {
+        auto vectors = randomVectors(context);
+
+        context.measure(vectors.size(), [&](std::size_t i) { return Matrix::normalize(vectors[i]).x(); });
+    });
+
+    benchmarks.add("Matrix::reflection", false, [](BenchmarkContext& context) {
+        auto directions = randomVectors(context);
+        auto normals = randomVectors(context);
+
+        context.measure(directions.size(), [&](std::size_t i) {
+            return Matrix::reflection(directions[i], normals[i]).x();
+        });
+    });
+
+    benchmarks.add("Matrix::refraction", false, [](BenchmarkContext& context) {
+        auto directions = randomVectors(context);
+        auto normals = randomVectors(context);
+
+        // Entering and leaving glass (some total internal reflections)
+        context.measure(directions.size(), [&](std::size_t i) {
+            return (i & 1) == 0 ? Matrix::refraction(directions[i], normals[i], 1.0, 1.5).x()
+                                : Matrix::refraction(directions[i], normals[i], 1.5, 1.0).x();
+        });
+    });
+}
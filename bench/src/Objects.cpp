@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+#include "Generators.h"
+
+#include <Accelerators/SphereBatch.h>
+#include <Objects/Model.h>
+#include <Objects/Plane.h>
+#include <Objects/Sphere.h>
+#include <Objects/Triangle.h>
+
+namespace
+{
+    /**
+     * The number of rays of each benchmark.
+     */
+    constexpr std::size_t RAY_COUNT = 4096;
+
+    /**
+     * @brief Measure the intersection of random rays going toward an object (and around it).
+     */
+    void measureIntersection(BenchmarkContext& context, const Object& object, const Vector3& center, double radius)
+    {
+        auto rays = randomRays(context, RAY_COUNT, Vector3(0, 0, -10), 4, center, radius * 2);
+
+        context.measure(rays.size(), [&](std::size_t i) { return object.getIntersection(rays[i]).has_value(); });
+    }
+} // namespace
+
+void addObjectBenchmarks(Benchmarks& benchmarks)
+{
+    benchmarks.add("Sphere::getIntersection", true, [](BenchmarkContext& context) {
+        Sphere sphere(Materials::metal(), Colors::white(), Vector3(0, 0, 10), 2);
+
+        measureIntersection(context, sphere, Vector3(0, 0, 10), 2);
+    });
+
+    benchmarks.add("SphereBatch::intersect", true, [](BenchmarkContext& context) {
+        // A full BVH leaf of spheres, the closest one is searched
+        SphereBatch batch;
+        for (std::size_t i = 0; i < SphereBatch::WIDTH; i++)
+            batch.add(Vector3(context.random(-2, 2), context.random(-2, 2), context.random(8, 12)), 0.5);
+
+        auto rays = randomRays(context, RAY_COUNT, Vector3(0, 0, -10), 4, Vector3(0, 0, 10), 4);
+
+        context.measure(rays.size(),
+                        [&](std::size_t i) { return batch.intersect(rays[i], 0, SphereBatch::WIDTH).has_value(); });
+    });
+
+    benchmarks.add("Plane::getIntersection", true, [](BenchmarkContext& context) {
+        Plane plane(Materials::metal(), Colors::white(), Vector3(0, 0, 10), Vector3(0, 1, -1));
+
+        measureIntersection(context, plane, Vector3(0, 0, 10), 2);
+    });
+
+    benchmarks.add("Triangle::getIntersection", true, [](BenchmarkContext& context) {
+        Triangle triangle(
+                Materials::metal(), Colors::white(), Vector3(-2, -2, 10), Vector3(2, -2, 10), Vector3(0, 2, 10));
+
+        measureIntersection(context, triangle, Vector3(0, 0, 10), 2);
+    });
+
+    benchmarks.add("Model::getIntersection", true, [](BenchmarkContext& context) {
+        // UV sphere of 20000 triangles
+        TemporarySphereMesh mesh(100, 100);
+        Model model(Materials::metal(), Colors::white(), mesh.getPath(), Vector3(0, 0, 10), Vector3(0, 0, 0), 2);
+
+        measureIntersection(context, model, Vector3(0, 0, 10), 2);
+    });
+}
@@ -0,0 +1,156 @@
+#include "Benchmark.h"
+#include "Generators.h"
+
+#include <Light/Punctual.h>
+#include <Objects/Model.h>
+#include <Objects/Plane.h>
+#include <Objects/Sphere.h>
+#include <Scene/Scene.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * The resolution of the renders.
+     */
+    constexpr std::size_t WIDTH = 640;
+    constexpr std::size_t HEIGHT = 360;
+
+    /**
+     * @brief Scene giving access to its render.
+     */
+    class BenchmarkScene : public Scene
+    {
+    public:
+        BenchmarkScene() : Scene(Scene::camera(Vector3(0, 0, -10), Vector3(0, 0, 1), Size(WIDTH, HEIGHT), 1), 0.1)
+        {
+        }
+
+        using Scene::compute;
+    };
+
+    /**
+     * @brief Add a floor and two lights.
+     */
+    void addStage(BenchmarkScene& scene)
+    {
+        scene.addLight<Punctual>(8, Colors::white(), Vector3(10, -10, 0));
+        scene.addLight<Punctual>(4, Color(255, 200, 150), Vector3(-10, -5, 5));
+        scene.addObject<Plane>(Materials::metal(0.2), Color(200, 200, 200), Vector3(0, 4, 0), Vector3(0, -1, 0));
+    }
+
+    Color randomColor(BenchmarkContext& context)
+    {
+        return Color(static_cast<uint8_t>(context.random(50, 256)),
+                     static_cast<uint8_t>(context.random(50, 256)),
+                     static_cast<uint8_t>(context.random(50, 256)));
+    }
+
+    /**
+     * @brief Add spheres in the field of view, about as dense whatever their number.
+     */
+    void addSpheres(BenchmarkContext& context, BenchmarkScene& scene, std::size_t count)
+    {
+        double radius = 3.0 / std::cbrt(static_cast<double>(count));
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            Vector3 center(context.random(-14, 14), context.random(-8, 4), context.random(5, 45));
+            Material material = context.random() < 0.2 ? Materials::metal(0.6) : Materials::metal();
+
+            scene.addObject<Sphere>(material, randomColor(context), center, radius * context.random(0.5, 1));
+        }
+    }
+
+    /**
+     * @brief Measure the render of a scene, with the number of rays of each type.
+     */
+    void measureRender(BenchmarkContext& context, BenchmarkScene& scene, unsigned int recursivity)
+    {
+        scene.buildBVH();
+
+        context.measure(1, [&](std::size_t /* index */) {
+            auto pixels = scene.compute(recursivity).toRGB();
+
+            // Sum of the channels, the same for every run
+            double sum = 0.0;
+            for (std::uint8_t channel : pixels)
+                sum += channel;
+
+            return sum;
+        });
+
+        const auto& statistics = scene.getRenderStatistics();
+        double seconds = context.getResult().nsPerCall * 1e-9;
+
+        context.setCounter("primary_rays", static_cast<double>(statistics.primaryRayCount));
+        context.setCounter("shadow_rays", static_cast<double>(statistics.shadowRayCount));
+        context.setCounter("reflection_rays", static_cast<double>(statistics.reflectionRayCount));
+        context.setCounter("refraction_rays", static_cast<double>(statistics.refractionRayCount));
+        context.setCounter("rays", static_cast<double>(statistics.getRayCount()));
+        context.setCounter("threads", static_cast<double>(statistics.threadCount));
+        context.setCounter("wall_time_ms", seconds * 1e3);
+        context.setCounter("rays_per_second_per_core",
+                           static_cast<double>(statistics.getRayCount()) / seconds /
+                                   static_cast<double>(statistics.threadCount));
+    }
+} // namespace
+
+void addRenderBenchmarks(Benchmarks& benchmarks)
+{
+    for (std::size_t count : {10, 1000, 100000})
+    {
+        benchmarks.add("Render/spheres-" + std::to_string(count), false, [count](BenchmarkContext& context) {
+            BenchmarkScene scene;
+            addStage(scene);
+            addSpheres(context, scene, count);
+
+            measureRender(context, scene, 1);
+        });
+    }
+
+    benchmarks.add("Render/mesh", false, [](BenchmarkContext& context) {
+        BenchmarkScene scene;
+        addStage(scene);
+
+        // UV sphere of 180000 triangles
+        TemporarySphereMesh mesh(300, 300);
+        scene.addObject<Model>(
+                Materials::metal(0.3), randomColor(context), mesh.getPath(), Vector3(0, 0, 15), Vector3(), 5.0);
+
+        measureRender(context, scene, 1);
+    });
+
+    benchmarks.add("Render/recursion", false, [](BenchmarkContext& context) {
+        BenchmarkScene scene;
+        addStage(scene);
+
+        // Mirrors and glass spheres reflecting each other
+        for (int i = 0; i < 8; i++)
+        {
+            Vector3 center(-10.5 + i * 3.0, context.random(-2, 2), context.random(8, 14));
+            Material material = i % 2 == 0 ? Materials::metal(0.9) : Materials::transparent();
+
+            scene.addObject<Sphere>(material, randomColor(context), center, 1.4);
+        }
+
+        measureRender(context, scene, 8);
+    });
+
+    benchmarks.add("Render/lights", false, [](BenchmarkContext& context) {
+        BenchmarkScene scene;
+        addStage(scene);
+        addSpheres(context, scene, 100);
+
+        // Grid of 64 small lights over the scene
+        for (int i = 0; i < 64; i++)
+        {
+            Vector3 origin(-14 + (i % 8) * 4.0, -12, 5 + (i / 8) * 5.0);
+            scene.addLight<Punctual>(0.5, randomColor(context), origin);
+        }
+
+        measureRender(context, scene, 1);
+    });
+}
@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+#include "Generators.h"
+
+#include <Light/Punctual.h>
+#include <Objects/Plane.h>
+#include <Objects/Sphere.h>
+#include <Scene/Scene.h>
+
+#include <array>
+
+namespace
+{
+    /**
+     * @brief Scene giving access to its shading functions.
+     */
+    class BenchmarkScene : public Scene
+    {
+    public:
+        using Scene::Scene;
+
+        using Scene::computeLight;
+        using Scene::getIntersectedObject;
+        using Scene::getIntersectedObjects;
+    };
+
+    /**
+     * The resolution of the primary rays benchmarks (one ray per pixel).
+     */
+    constexpr std::size_t WIDTH = 128;
+    constexpr std::size_t HEIGHT = 64;
+
+    /**
+     * @brief Add a floor and 1000 spheres in the field of view.
+     */
+    void addObjects(BenchmarkContext& context, BenchmarkScene& scene)
+    {
+        scene.addObject<Plane>(Materials::metal(), Colors::white(), Vector3(0, 4, 0), Vector3(0, -1, 0));
+        for (int i = 0; i < 1000; i++)
+        {
+            Vector3 center(context.random(-14, 14), context.random(-8, 4), context.random(5, 45));
+            scene.addObject<Sphere>(Materials::metal(), Colors::white(), center, context.random(0.15, 0.3));
+        }
+
+        scene.buildBVH();
+    }
+
+    /**
+     * @brief Get the rays from the camera through each pixel, listed by blocks of 4 * 4 pixels (like the render).
+     */
+    std::vector<Ray> primaryRays()
+    {
+        std::vector<Ray> rays;
+        for (std::size_t blockY = 0; blockY < HEIGHT; blockY += 4)
+        {
+            for (std::size_t blockX = 0; blockX < WIDTH; blockX += 4)
+            {
+                for (std::size_t y = blockY; y < blockY + 4; y++)
+                {
+                    for (std::size_t x = blockX; x < blockX + 4; x++)
+                    {
+                        Vector3 direction(static_cast<double>(x) / WIDTH * 2 - 1,
+                                          (static_cast<double>(y) / HEIGHT * 2 - 1) * HEIGHT / WIDTH,
+                                          1);
+                        rays.emplace_back(Vector3(0, 0, -10), direction.normalize(), PRIMARY);
+                    }
+                }
+            }
+        }
+
+        return rays;
+    }
+
+    /**
+     * @brief A visible point of the scene, with the ray which found it.
+     */
+    struct ShadingPoint
+    {
+        ObjectId object;
+        HitRecord hit;
+        Ray ray;
+    };
+} // namespace
+
+void addSceneBenchmarks(Benchmarks& benchmarks)
+{
+    benchmarks.add("Scene::computeLight", false, [](BenchmarkContext& context) {
+        BenchmarkScene scene(Scene::camera(Vector3(0, 0, -10), Vector3(0, 0, 1), Size(256, 144), 1));
+
+        // 4 lights and spheres over a plane, so the shadow rays are sometimes blocked
+        scene.addLight<Punctual>(8, Colors::white(), Vector3(10, -10, 0));
+        scene.addLight<Punctual>(4, Colors::red(), Vector3(-10, -5, 5));
+        scene.addLight<Punctual>(4, Colors::green(), Vector3(0, -10, 20));
+        scene.addLight<Punctual>(2, Colors::blue(), Vector3(0, 0, -5));
+
+        scene.addObject<Plane>(Materials::metal(), Colors::white(), Vector3(0, 3, 0), Vector3(0, -1, 0));
+        for (int i = 0; i < 16; i++)
+        {
+            Vector3 center(context.random(-8, 8), context.random(-4, 2), context.random(5, 25));
+            scene.addObject<Sphere>(Materials::metal(), Colors::white(), center, context.random(0.5, 2));
+        }
+
+        scene.buildBVH();
+
+        // Points seen from the camera
+        std::vector<ShadingPoint> points;
+        while (points.size() < 1024)
+        {
+            Vector3 direction(context.random(-1, 1), context.random(-0.6, 0.6), 1);
+            Ray ray(Vector3(0, 0, -10), direction.normalize(), PRIMARY);
+
+            auto intersection = scene.getIntersectedObject(ray);
+            if (intersection.has_value())
+                points.push_back({intersection->first, intersection->second, ray});
+        }
+
+        context.measure(points.size(), [&](std::size_t i) {
+            const auto& point = points[i];
+
+            return scene.computeLight(point.object, point.hit, point.ray).first;
+        });
+    });
+
+    benchmarks.add("Scene::getIntersectedObject", true, [](BenchmarkContext& context) {
+        BenchmarkScene scene(Scene::camera(Vector3(0, 0, -10), Vector3(0, 0, 1), Size(WIDTH, HEIGHT), 1));
+        addObjects(context, scene);
+
+        std::vector<Ray> rays = primaryRays();
+
+        context.measure(rays.size(), [&](std::size_t i) { return scene.getIntersectedObject(rays[i]).has_value(); });
+    });
+
+    benchmarks.add("Scene::getIntersectedObjects", false, [](BenchmarkContext& context) {
+        BenchmarkScene scene(Scene::camera(Vector3(0, 0, -10), Vector3(0, 0, 1), Size(WIDTH, HEIGHT), 1));
+        addObjects(context, scene);
+
+        // The same rays, by packets
+        std::vector<Ray> rays = primaryRays();
+        std::vector<RayPacket> packets(rays.size() / RayPacket::SIZE);
+        for (std::size_t i = 0; i < rays.size(); i++)
+            packets[i / RayPacket::SIZE].setRay(i % RayPacket::SIZE, rays[i]);
+
+        std::array<IntersectionResult, RayPacket::SIZE> results;
+
+        context.measure(packets.size(), [&](std::size_t i) {
+            // The intersections lower the tMax of the lanes
+            RayPacket packet = packets[i];
+            scene.getIntersectedObjects(packet, RayPacket::firstLanes(RayPacket::SIZE), results);
+
+            std::size_t hits = 0;
+            for (const auto& result : results)
+                hits += result.has_value() ? 1 : 0;
+
+            return hits;
+        });
+
+        context.setCounter("ns_per_ray", context.getResult().nsPerCall / RayPacket::SIZE);
+    });
+}
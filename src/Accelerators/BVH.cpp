@@ -0,0 +1,526 @@
+#include "BVH.h"
+
+#include "Utils/Simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    double axisValue(const Vector3& vector, std::size_t axis)
+    {
+        switch (axis)
+        {
+            case 0:
+                return vector.x();
+            case 1:
+                return vector.y();
+            default:
+                return vector.z();
+        }
+    }
+
+    std::size_t binIndex(double center, double min, double scale)
+    {
+        auto index = static_cast<std::size_t>((center - min) * scale);
+
+        return std::min(index, BVH::SAH_BIN_COUNT - 1);
+    }
+
+    /**
+     * @brief Slab test of every child of a wide node, the result of each child is 1 (hit) or 0.
+     */
+    SIMD_CLONES void intersectChildren(const BVH::WideNode& node,
+                                       const Vector3& origin,
+                                       const Vector3& inverseDirection,
+                                       double tMax,
+                                       BVH::WideNode::Bounds& tNear,
+                                       std::array<std::int64_t, BVH::WIDE_NODE_SIZE>& hits)
+    {
+        const double originX = origin.x();
+        const double originY = origin.y();
+        const double originZ = origin.z();
+        const double inverseX = inverseDirection.x();
+        const double inverseY = inverseDirection.y();
+        const double inverseZ = inverseDirection.z();
+
+        for (std::size_t i = 0; i < BVH::WIDE_NODE_SIZE; i++)
+        {
+            double t0 = (node.minX[i] - originX) * inverseX;
+            double t1 = (node.maxX[i] - originX) * inverseX;
+
+            double near = std::min(t0, t1);
+            double far = std::max(t0, t1);
+
+            t0 = (node.minY[i] - originY) * inverseY;
+            t1 = (node.maxY[i] - originY) * inverseY;
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+
+            t0 = (node.minZ[i] - originZ) * inverseZ;
+            t1 = (node.maxZ[i] - originZ) * inverseZ;
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+
+            // Same robustness factor as BoundingBox::intersect()
+            far *= 1.0 + 4.0 * std::numeric_limits<double>::epsilon();
+
+            tNear[i] = near;
+            hits[i] = !((near > far) | (far < 0.0) | (near > tMax));
+        }
+    }
+} // namespace
+
+/**
+ * @brief Shared state of a build.
+ */
+struct BVH::BuildContext
+{
+    const std::vector<BoundingBox>& boxes;
+    const std::vector<Vector3>& centers;
+
+    /**
+     * The nodes and primitive indices being built.
+     */
+    std::vector<Node>& nodes;
+    std::vector<std::uint32_t>& indices;
+
+    /**
+     * Next free node (nodes are allocated by pairs).
+     */
+    std::atomic<std::uint32_t> nodeCount;
+
+    /**
+     * Depth until which the subtrees are built in parallel.
+     */
+    std::size_t parallelDepth;
+};
+
+void BVH::build(const std::vector<BoundingBox>& boxes)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    clear();
+
+    if (boxes.empty())
+        return;
+
+    std::vector<Vector3> centers;
+    centers.reserve(boxes.size());
+    for (const auto& box : boxes)
+        centers.emplace_back(box.center());
+
+    std::vector<std::uint32_t> indices(boxes.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // A binary tree with n leaves has at most 2n - 1 nodes, allocated upfront so that threads can fill it
+    std::vector<Node> nodes(2 * boxes.size() - 1);
+
+    // Each level of parallel recursion doubles the number of tasks
+    std::size_t parallelDepth = 0;
+    for (std::size_t tasks = 1; tasks < std::max(1U, std::thread::hardware_concurrency()); tasks *= 2)
+        parallelDepth++;
+
+    BuildContext context{boxes, centers, nodes, indices, {1}, parallelDepth};
+
+    buildNode(0, 0, boxes.size(), 0, context);
+
+    nodes.resize(context.nodeCount);
+    nodes.shrink_to_fit();
+
+    m_nodes = Buffer<Node>(std::move(nodes));
+    m_indices = Buffer<std::uint32_t>(std::move(indices));
+
+    computeStatistics();
+    buildWideNodes();
+    m_statistics.buildTime =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BVH::assign(Buffer<Node> nodes, Buffer<std::uint32_t> indices, const Statistics& statistics)
+{
+    m_nodes = std::move(nodes);
+    m_indices = std::move(indices);
+    m_statistics = statistics;
+
+    buildWideNodes();
+}
+
+bool BVH::isValid(const Buffer<Node>& nodes, const Buffer<std::uint32_t>& indices, std::size_t primitiveCount)
+{
+    if (!std::all_of(indices.begin(), indices.end(), [primitiveCount](std::uint32_t index) {
+            return index < primitiveCount;
+        }))
+        return false;
+
+    if (nodes.empty())
+        return indices.empty();
+
+    // Walk the tree from the root: a node reached twice would be shared (or in a cycle)
+    std::vector<bool> reached(nodes.size(), false);
+    std::vector<std::pair<std::size_t, std::size_t>> stack = {{0, 1}};
+    while (!stack.empty())
+    {
+        auto [index, depth] = stack.back();
+        stack.pop_back();
+
+        if (reached[index] || depth > MAX_DEPTH)
+            return false;
+        reached[index] = true;
+
+        const Node& node = nodes[index];
+        if (node.count != 0)
+        {
+            if (static_cast<std::size_t>(node.offset) + node.count > indices.size())
+                return false;
+        }
+        else
+        {
+            if (static_cast<std::size_t>(node.offset) + 1 >= nodes.size())
+                return false;
+
+            stack.emplace_back(node.offset, depth + 1);
+            stack.emplace_back(node.offset + 1, depth + 1);
+        }
+    }
+
+    return true;
+}
+
+void BVH::clear()
+{
+    m_nodes = Buffer<Node>();
+    m_wideNodes.clear();
+    m_indices = Buffer<std::uint32_t>();
+    m_statistics = Statistics();
+}
+
+bool BVH::empty() const
+{
+    return m_nodes.empty();
+}
+
+BoundingBox BVH::getBoundingBox() const
+{
+    if (m_nodes.empty())
+        return BoundingBox();
+
+    return m_nodes.front().box;
+}
+
+const Buffer<BVH::Node>& BVH::getNodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<BVH::WideNode>& BVH::getWideNodes() const
+{
+    return m_wideNodes;
+}
+
+const Buffer<std::uint32_t>& BVH::getIndices() const
+{
+    return m_indices;
+}
+
+const BVH::Statistics& BVH::getStatistics() const
+{
+    return m_statistics;
+}
+
+void BVH::printStatistics(const std::string& name) const
+{
+    if (!name.empty())
+        std::cout << "BVH '" << name << "' statistics:" << std::endl;
+    else
+        std::cout << "BVH statistics:" << std::endl;
+
+    std::cout << "  primitives: " << m_statistics.primitiveCount << std::endl
+              << "  nodes:      " << m_statistics.nodeCount << " (" << m_statistics.leafCount << " leaves)"
+              << std::endl
+              << "  wide nodes: " << m_wideNodes.size() << std::endl
+              << "  depth:      " << m_statistics.depth << std::endl
+              << "  SAH cost:   " << m_statistics.sahCost << std::endl
+              << "  build time: " << m_statistics.buildTime << " ms" << std::endl;
+}
+
+unsigned int BVH::intersect(const WideNode& node,
+                           const Vector3& origin,
+                           const Vector3& inverseDirection,
+                           double tMax,
+                           WideNode::Bounds& tNear)
+{
+    std::array<std::int64_t, WIDE_NODE_SIZE> hits;
+    intersectChildren(node, origin, inverseDirection, tMax, tNear, hits);
+
+    unsigned int res = 0;
+    for (std::size_t i = 0; i < WIDE_NODE_SIZE; i++)
+        res |= static_cast<unsigned int>(hits[i]) << i;
+
+    return res & ((1U << node.childCount) - 1);
+}
+
+void BVH::buildNode(std::size_t nodeIndex, std::size_t begin, std::size_t end, std::size_t depth, BuildContext& context)
+{
+    BoundingBox box;
+    BoundingBox centerBox;
+    for (std::size_t i = begin; i < end; i++)
+    {
+        box.extend(context.boxes[context.indices[i]]);
+        centerBox.extend(context.centers[context.indices[i]]);
+    }
+
+    Node& node = context.nodes[nodeIndex];
+    node.box = box;
+
+    std::size_t count = end - begin;
+    std::size_t axis = centerBox.largestAxis();
+    double extent = centerBox.extent(axis);
+
+    auto makeLeaf = [&]() {
+        node.offset = static_cast<std::uint32_t>(begin);
+        node.count = static_cast<std::uint32_t>(count);
+    };
+
+    // All the centers at the same place can't be split
+    if (count == 1 || depth >= MAX_DEPTH - 1 || extent <= 0.0)
+    {
+        makeLeaf();
+        return;
+    }
+
+    // Bin the primitives along the axis
+    std::array<BoundingBox, SAH_BIN_COUNT> binBoxes;
+    std::array<std::size_t, SAH_BIN_COUNT> binCounts{};
+
+    double min = axisValue(centerBox.min(), axis);
+    double scale = static_cast<double>(SAH_BIN_COUNT) / extent;
+
+    for (std::size_t i = begin; i < end; i++)
+    {
+        std::size_t bin = binIndex(axisValue(context.centers[context.indices[i]], axis), min, scale);
+        binBoxes[bin].extend(context.boxes[context.indices[i]]);
+        binCounts[bin]++;
+    }
+
+    // Sweep from the right to get the cost of each right side, then from the left to evaluate every split plane
+    std::array<double, SAH_BIN_COUNT> rightCosts{};
+    BoundingBox rightBox;
+    std::size_t rightCount = 0;
+    for (std::size_t bin = SAH_BIN_COUNT - 1; bin > 0; bin--)
+    {
+        rightBox.extend(binBoxes[bin]);
+        rightCount += binCounts[bin];
+        rightCosts[bin] = rightBox.surfaceArea() * static_cast<double>(rightCount);
+    }
+
+    std::size_t bestSplit = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    BoundingBox leftBox;
+    std::size_t leftCount = 0;
+    for (std::size_t split = 1; split < SAH_BIN_COUNT; split++)
+    {
+        leftBox.extend(binBoxes[split - 1]);
+        leftCount += binCounts[split - 1];
+
+        if (leftCount == 0 || leftCount == count)
+            continue;
+
+        double cost = leftBox.surfaceArea() * static_cast<double>(leftCount) + rightCosts[split];
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSplit = split;
+        }
+    }
+
+    double area = box.surfaceArea();
+    double splitCost = SAH_TRAVERSAL_COST + SAH_INTERSECTION_COST * bestCost / area;
+    double leafCost = SAH_INTERSECTION_COST * static_cast<double>(count);
+
+    if (count <= MAX_LEAF_SIZE && leafCost <= splitCost)
+    {
+        makeLeaf();
+        return;
+    }
+
+    auto first = context.indices.begin() + static_cast<std::ptrdiff_t>(begin);
+    auto last = context.indices.begin() + static_cast<std::ptrdiff_t>(end);
+    std::size_t middle = 0;
+
+    if (bestSplit != 0)
+    {
+        middle = static_cast<std::size_t>(std::partition(first,
+                                                         last,
+                                                         [&](std::size_t index) {
+                                                             return binIndex(axisValue(context.centers[index], axis),
+                                                                             min,
+                                                                             scale) < bestSplit;
+                                                         }) -
+                                          context.indices.begin());
+    }
+
+    // Fallback on a median split if the binning couldn't separate the primitives
+    if (middle <= begin || middle >= end)
+    {
+        middle = begin + count / 2;
+        std::nth_element(first,
+                         context.indices.begin() + static_cast<std::ptrdiff_t>(middle),
+                         last,
+                         [&](std::size_t a, std::size_t b) {
+                             return axisValue(context.centers[a], axis) < axisValue(context.centers[b], axis);
+                         });
+    }
+
+    std::uint32_t left = context.nodeCount.fetch_add(2);
+
+    node.offset = left;
+    node.count = 0;
+    node.axis = static_cast<std::uint32_t>(axis);
+
+    // Big subtrees near the root are built in parallel
+    if (depth < context.parallelDepth && count >= PARALLEL_BUILD_THRESHOLD)
+    {
+        auto leftTask = std::async(std::launch::async, [&, left, begin, middle, depth]() {
+            buildNode(left, begin, middle, depth + 1, context);
+        });
+
+        buildNode(left + 1, middle, end, depth + 1, context);
+        leftTask.get();
+    }
+    else
+    {
+        buildNode(left, begin, middle, depth + 1, context);
+        buildNode(left + 1, middle, end, depth + 1, context);
+    }
+}
+
+void BVH::computeStatistics()
+{
+    m_statistics = Statistics();
+
+    if (m_nodes.empty())
+        return;
+
+    m_statistics.primitiveCount = m_indices.size();
+    m_statistics.nodeCount = m_nodes.size();
+
+    double rootArea = m_nodes.front().box.surfaceArea();
+
+    std::vector<std::pair<std::uint32_t, std::size_t>> stack = {{0, 1}};
+    while (!stack.empty())
+    {
+        auto [index, depth] = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[index];
+        double relativeArea = rootArea > 0.0 ? node.box.surfaceArea() / rootArea : 1.0;
+
+        m_statistics.depth = std::max(m_statistics.depth, depth);
+
+        if (node.count != 0)
+        {
+            m_statistics.leafCount++;
+            m_statistics.sahCost += SAH_INTERSECTION_COST * static_cast<double>(node.count) * relativeArea;
+        }
+        else
+        {
+            m_statistics.sahCost += SAH_TRAVERSAL_COST * relativeArea;
+            stack.emplace_back(node.offset, depth + 1);
+            stack.emplace_back(node.offset + 1, depth + 1);
+        }
+    }
+}
+
+void BVH::buildWideNodes()
+{
+    m_wideNodes.clear();
+
+    if (m_nodes.empty())
+        return;
+
+    if (m_nodes.front().count == 0)
+    {
+        collapseNode(0);
+        return;
+    }
+
+    // A single leaf, under a wide root
+    const Node& root = m_nodes.front();
+
+    WideNode node;
+    node.minX[0] = root.box.min().x();
+    node.minY[0] = root.box.min().y();
+    node.minZ[0] = root.box.min().z();
+    node.maxX[0] = root.box.max().x();
+    node.maxY[0] = root.box.max().y();
+    node.maxZ[0] = root.box.max().z();
+    node.offsets[0] = root.offset;
+    node.counts[0] = root.count;
+    node.childCount = 1;
+
+    m_wideNodes.push_back(node);
+}
+
+std::uint32_t BVH::collapseNode(std::uint32_t nodeIndex)
+{
+    auto wideIndex = static_cast<std::uint32_t>(m_wideNodes.size());
+    m_wideNodes.emplace_back();
+
+    const Node& binaryNode = m_nodes[nodeIndex];
+    std::array<std::uint32_t, WIDE_NODE_SIZE> children{binaryNode.offset, binaryNode.offset + 1};
+    std::size_t childCount = 2;
+
+    // Open the biggest interior child until the node is full
+    while (childCount < WIDE_NODE_SIZE)
+    {
+        std::size_t biggest = childCount;
+        double biggestArea = -1.0;
+        for (std::size_t i = 0; i < childCount; i++)
+        {
+            const Node& child = m_nodes[children[i]];
+            if (child.count == 0 && child.box.surfaceArea() > biggestArea)
+            {
+                biggest = i;
+                biggestArea = child.box.surfaceArea();
+            }
+        }
+
+        if (biggest == childCount)
+            break;
+
+        std::uint32_t opened = children[biggest];
+        children[biggest] = m_nodes[opened].offset;
+        children[childCount++] = m_nodes[opened].offset + 1;
+    }
+
+    WideNode node;
+    node.childCount = static_cast<std::uint32_t>(childCount);
+
+    for (std::size_t i = 0; i < childCount; i++)
+    {
+        const Node& child = m_nodes[children[i]];
+
+        node.minX[i] = child.box.min().x();
+        node.minY[i] = child.box.min().y();
+        node.minZ[i] = child.box.min().z();
+        node.maxX[i] = child.box.max().x();
+        node.maxY[i] = child.box.max().y();
+        node.maxZ[i] = child.box.max().z();
+        node.counts[i] = child.count;
+        node.offsets[i] = child.count != 0 ? child.offset : collapseNode(children[i]);
+    }
+
+    m_wideNodes[wideIndex] = node;
+
+    return wideIndex;
+}
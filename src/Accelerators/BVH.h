@@ -0,0 +1,536 @@
+#ifndef H_RAYTRACING_BVH_H
+#define H_RAYTRACING_BVH_H
+
+#include "Utils/BoundingBox.h"
+#include "Utils/Buffer.h"
+#include "Utils/Ray.h"
+#include "Utils/RayPacket.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class BVH
+ * @brief Bounding volume hierarchy over a set of primitives.
+ *
+ * The hierarchy only knows the bounding boxes of the primitives, the actual intersection test is given by the caller
+ * at traversal time. The nodes are stored in a flat array (the two children of a node are stored next to each
+ * other) and the primitives are referenced by their index in the array given to build().
+ *
+ * The builder uses the surface area heuristic (SAH) evaluated on bins, and builds the big subtrees in parallel.
+ *
+ * The single rays traverse a wide version of the tree, collapsed from the binary one after each build: each wide
+ * node has up to WIDE_NODE_SIZE children whose bounds are stored by coordinate, so that a ray is tested against all
+ * of them at once (SIMD). The ray packets traverse the binary tree, they are already tested several at once.
+ *
+ * @see BoundingBox
+ */
+class BVH
+{
+public:
+    /**
+     * @struct Node
+     * @brief A node of the hierarchy.
+     */
+    struct Node
+    {
+        /**
+         * The bounds of everything under this node.
+         */
+        BoundingBox box;
+
+        /**
+         * Index of the left child (interior node) or of the first primitive (leaf).
+         */
+        std::uint32_t offset = 0;
+
+        /**
+         * Number of primitives (0 for an interior node).
+         */
+        std::uint32_t count = 0;
+
+        /**
+         * The axis used to split the node (used to order the traversal).
+         */
+        std::uint32_t axis = 0;
+
+        /**
+         * Unused, makes the padding explicit so that the nodes can be written as is in a file.
+         */
+        std::uint32_t reserved = 0;
+    };
+
+    /**
+     * Number of children of a wide node (4 doubles fill an AVX2 register).
+     */
+    static constexpr std::size_t WIDE_NODE_SIZE = 4;
+
+    /**
+     * @struct WideNode
+     * @brief A node of the wide hierarchy, with the bounds of its children stored by coordinate.
+     */
+    struct alignas(64) WideNode
+    {
+        using Bounds = std::array<double, WIDE_NODE_SIZE>;
+
+        Bounds minX{}; /*!< Bounds of the children. */
+        Bounds minY{};
+        Bounds minZ{};
+        Bounds maxX{};
+        Bounds maxY{};
+        Bounds maxZ{};
+
+        /**
+         * Index of the wide node of each child (interior child) or of its first primitive (leaf child).
+         */
+        std::array<std::uint32_t, WIDE_NODE_SIZE> offsets{};
+
+        /**
+         * Number of primitives of each child (0 for an interior child).
+         */
+        std::array<std::uint32_t, WIDE_NODE_SIZE> counts{};
+
+        /**
+         * Number of children, the next slots are unused.
+         */
+        std::uint32_t childCount = 0;
+    };
+
+    /**
+     * @struct Statistics
+     * @brief Statistics of the last build.
+     */
+    struct Statistics
+    {
+        std::size_t primitiveCount = 0; /*!< Number of primitives. */
+        std::size_t nodeCount = 0;      /*!< Number of nodes (interior and leaves). */
+        std::size_t leafCount = 0;      /*!< Number of leaves. */
+        std::size_t depth = 0;          /*!< Depth of the deepest leaf (the root is at depth 1). */
+        double sahCost = 0.0;           /*!< SAH cost of the whole tree (expected cost of a ray traversal). */
+        double buildTime = 0.0;         /*!< Build time in milliseconds. */
+    };
+
+    /**
+     * @brief Build the hierarchy.
+     *
+     * @param boxes The bounding boxes of the primitives (must be finite).
+     */
+    void build(const std::vector<BoundingBox>& boxes);
+
+    /**
+     * @brief Use an already built hierarchy (like one read from a cache file).
+     *
+     * @param nodes      The nodes (as given by getNodes()).
+     * @param indices    The primitive indices (as given by getIndices()).
+     * @param statistics The statistics of the build.
+     */
+    void assign(Buffer<Node> nodes, Buffer<std::uint32_t> indices, const Statistics& statistics);
+
+    /**
+     * @brief Know if some nodes and indices form a hierarchy that can be assigned (like the ones of a cache file).
+     *
+     * The children and the primitive ranges must be in the arrays, every node must have a single parent, the depth
+     * must not be more than the traversal handles and the indices must be below the primitive count.
+     *
+     * @param nodes          The nodes.
+     * @param indices        The primitive indices.
+     * @param primitiveCount The number of primitives.
+     *
+     * @return Returns true if the hierarchy is valid.
+     */
+    static bool isValid(const Buffer<Node>& nodes, const Buffer<std::uint32_t>& indices, std::size_t primitiveCount);
+
+    /**
+     * @brief Clear the hierarchy.
+     */
+    void clear();
+
+    /**
+     * @brief Know if the hierarchy is empty.
+     *
+     * @return Returns true if there is no primitive in the hierarchy.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the bounds of the whole hierarchy.
+     *
+     * @return Returns the root bounding box.
+     */
+    BoundingBox getBoundingBox() const;
+
+    /**
+     * @brief Get the nodes of the hierarchy.
+     *
+     * @return Returns the nodes, the root is the first one.
+     */
+    const Buffer<Node>& getNodes() const;
+
+    /**
+     * @brief Get the nodes of the wide hierarchy.
+     *
+     * @return Returns the wide nodes, the root is the first one.
+     */
+    const std::vector<WideNode>& getWideNodes() const;
+
+    /**
+     * @brief Get the primitive indices referenced by the leaves.
+     *
+     * @return Returns the primitive indices.
+     */
+    const Buffer<std::uint32_t>& getIndices() const;
+
+    /**
+     * @brief Get the statistics of the last build.
+     *
+     * @return Returns the build statistics.
+     */
+    const Statistics& getStatistics() const;
+
+    /**
+     * @brief Print the statistics of the last build.
+     *
+     * @param name The name of the hierarchy (optional).
+     */
+    void printStatistics(const std::string& name = "") const;
+
+    /**
+     * @brief Traverse the hierarchy with a ray, nearest nodes first.
+     *
+     * The ray goes through the wide hierarchy: the children of a node are tested at once, and the children hit are
+     * visited by distance (the farther ones are skipped if a closer hit is found meanwhile).
+     *
+     * The intersector is called for every primitive of the visited leaves with the signature
+     * 'bool intersector(std::size_t primitive, double& tMax)'. It must lower tMax when it finds a closer hit (tMax is
+     * a ray parameter, the nodes farther than tMax are skipped) and returns true to stop the traversal.
+     *
+     * @param ray         The ray.
+     * @param tMax        The maximum ray parameter to consider.
+     * @param intersector The intersection callback.
+     */
+    template<typename Intersector>
+    void traverse(const Ray& ray, double tMax, Intersector&& intersector) const
+    {
+        traverseLeaves(ray, tMax, [&](std::size_t begin, std::size_t count, double& leafMax) {
+            for (std::size_t i = begin; i < begin + count; i++)
+            {
+                if (intersector(m_indices[i], leafMax))
+                    return true;
+            }
+
+            return false;
+        });
+    }
+
+    /**
+     * @brief Traverse the hierarchy with a ray, nearest nodes first, a leaf at a time (see traverse()).
+     *
+     * The intersector is called for every visited leaf with the signature
+     * 'bool intersector(std::size_t begin, std::size_t count, double& tMax)': the primitives of the leaf are the
+     * count indices from begin in getIndices(), so the caller can store its primitives in this order and test a leaf
+     * at once. It must lower tMax when it finds a closer hit and returns true to stop the traversal.
+     *
+     * @param ray         The ray.
+     * @param tMax        The maximum ray parameter to consider.
+     * @param intersector The intersection callback.
+     */
+    template<typename LeafIntersector>
+    void traverseLeaves(const Ray& ray, double tMax, LeafIntersector&& intersector) const
+    {
+        if (m_wideNodes.empty())
+            return;
+
+        const Vector3& origin = ray.getOrigin();
+        const Vector3& direction = ray.getDirection();
+        const Vector3 inverseDirection(1.0 / direction.x(), 1.0 / direction.y(), 1.0 / direction.z());
+
+        // A wide node (count of 0) or a leaf, with the distance where the ray enters it
+        struct Entry
+        {
+            std::uint32_t offset;
+            std::uint32_t count;
+            double tNear;
+        };
+
+        // Each visited node replaces its entry by its children
+        std::array<Entry, (WIDE_NODE_SIZE - 1) * MAX_DEPTH + 1> stack{};
+        std::size_t stackSize = 0;
+        stack[stackSize++] = {0, 0, 0.0};
+
+        WideNode::Bounds tNear{};
+
+        while (stackSize != 0)
+        {
+            const Entry entry = stack[--stackSize];
+
+            // A closer hit was found since the entry was pushed
+            if (entry.tNear > tMax)
+                continue;
+
+            if (entry.count != 0)
+            {
+                if (intersector(entry.offset, entry.count, tMax))
+                    return;
+
+                continue;
+            }
+
+            const WideNode& node = m_wideNodes[entry.offset];
+            unsigned int hits = intersect(node, origin, inverseDirection, tMax, tNear);
+
+            // Push the children farthest first (popped last), insertion sort on a few entries
+            std::size_t first = stackSize;
+            for (std::size_t i = 0; i < WIDE_NODE_SIZE; i++)
+            {
+                if ((hits >> i & 1) == 0)
+                    continue;
+
+                Entry child = {node.offsets[i], node.counts[i], tNear[i]};
+
+                std::size_t position = stackSize++;
+                for (; position > first && stack[position - 1].tNear < child.tNear; position--)
+                    stack[position] = stack[position - 1];
+
+                stack[position] = child;
+            }
+        }
+    }
+
+    /**
+     * @brief Intersect a ray with all the children of a wide node.
+     *
+     * @param node             The wide node.
+     * @param origin           The origin of the ray.
+     * @param inverseDirection The inverse of the direction of the ray (per component).
+     * @param tMax             The maximum ray parameter to consider.
+     * @param tNear            The ray parameter where the ray enters each child hit.
+     *
+     * @return Returns the children hit in [0, tMax], one bit per child.
+     */
+    static unsigned int intersect(const WideNode& node,
+                                  const Vector3& origin,
+                                  const Vector3& inverseDirection,
+                                  double tMax,
+                                  WideNode::Bounds& tNear);
+
+    /**
+     * @brief Traverse the hierarchy with the rays of a packet, nearest nodes first.
+     *
+     * Each node is tested against all the active rays at once, only the rays hitting it go down to its children. When
+     * fewer than PACKET_MIN_RAYS rays are left, they finish the subtree one by one.
+     *
+     * The intersector is called for every primitive of the visited leaves with the signature
+     * 'void intersector(std::size_t primitive, RayPacket::Mask mask)'. It must intersect the rays of the mask and
+     * lower the tMax of the packet lanes when it finds closer hits (the nodes farther than tMax are skipped).
+     *
+     * @param packet      The rays.
+     * @param mask        The lanes to trace.
+     * @param intersector The intersection callback.
+     */
+    template<typename Intersector>
+    void traverse(RayPacket& packet, RayPacket::Mask mask, Intersector&& intersector) const
+    {
+        if (m_nodes.empty() || mask == 0)
+            return;
+
+        struct Entry
+        {
+            std::uint32_t node;
+            RayPacket::Mask mask;
+        };
+
+        std::array<Entry, MAX_DEPTH + 1> stack{};
+        std::size_t stackSize = 0;
+        stack[stackSize++] = {0, mask};
+
+        while (stackSize != 0)
+        {
+            const Entry entry = stack[--stackSize];
+            const Node& node = m_nodes[entry.node];
+
+            RayPacket::Mask active = node.box.intersect(packet, entry.mask);
+            if (active == 0)
+                continue;
+
+            if (RayPacket::count(active) < PACKET_MIN_RAYS)
+            {
+                for (RayPacket::Mask lanes = active; lanes != 0; lanes &= lanes - 1)
+                    traverseLane(packet, RayPacket::first(lanes), entry.node, intersector);
+
+                continue;
+            }
+
+            if (node.count != 0)
+            {
+                for (std::uint32_t i = node.offset; i < node.offset + node.count; i++)
+                    intersector(m_indices[i], active);
+
+                continue;
+            }
+
+            // Visit the child on the side of the first ray first (pushed last), the rays of a packet are coherent
+            std::size_t lane = RayPacket::first(active);
+            const std::array<double, 3> direction = {
+                    packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]};
+
+            if (direction[node.axis] < 0)
+            {
+                stack[stackSize++] = {node.offset, active};
+                stack[stackSize++] = {node.offset + 1, active};
+            }
+            else
+            {
+                stack[stackSize++] = {node.offset + 1, active};
+                stack[stackSize++] = {node.offset, active};
+            }
+        }
+    }
+
+    /**
+     * Maximum number of primitives in a leaf (bigger nodes are always split).
+     */
+    static constexpr std::size_t MAX_LEAF_SIZE = 8;
+
+    /**
+     * Maximum depth of the hierarchy (bounds the traversal stack).
+     */
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    /**
+     * Number of bins used to evaluate the SAH.
+     */
+    static constexpr std::size_t SAH_BIN_COUNT = 16;
+
+    /**
+     * Cost of visiting a node, relative to SAH_INTERSECTION_COST.
+     */
+    static constexpr double SAH_TRAVERSAL_COST = 1.0;
+
+    /**
+     * Cost of intersecting a primitive.
+     */
+    static constexpr double SAH_INTERSECTION_COST = 1.0;
+
+    /**
+     * Minimum number of primitives of a subtree to build it on another thread.
+     */
+    static constexpr std::size_t PARALLEL_BUILD_THRESHOLD = 4096;
+
+    /**
+     * Minimum number of active rays to keep traversing a subtree as a packet.
+     */
+    static constexpr std::size_t PACKET_MIN_RAYS = 4;
+
+private:
+    /**
+     * @brief Traverse a subtree with a single ray of a packet (see traverse()).
+     *
+     * @param packet      The rays.
+     * @param lane        The lane of the ray.
+     * @param nodeIndex   The root of the subtree.
+     * @param intersector The intersection callback, called with the mask of the lane.
+     */
+    template<typename Intersector>
+    void traverseLane(RayPacket& packet, std::size_t lane, std::uint32_t nodeIndex, Intersector& intersector) const
+    {
+        const Vector3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        const Vector3 inverseDirection(
+                packet.inverseDirectionX[lane], packet.inverseDirectionY[lane], packet.inverseDirectionZ[lane]);
+        const std::array<bool, 3> negative = {
+                packet.directionX[lane] < 0, packet.directionY[lane] < 0, packet.directionZ[lane] < 0};
+        const RayPacket::Mask mask = RayPacket::Mask(1) << lane;
+
+        std::array<std::uint32_t, MAX_DEPTH + 1> stack{};
+        std::size_t stackSize = 0;
+        stack[stackSize++] = nodeIndex;
+
+        double tNear = 0.0;
+
+        while (stackSize != 0)
+        {
+            const Node& node = m_nodes[stack[--stackSize]];
+
+            if (!node.box.intersect(origin, inverseDirection, packet.tMax[lane], tNear))
+                continue;
+
+            if (node.count != 0)
+            {
+                for (std::uint32_t i = node.offset; i < node.offset + node.count; i++)
+                    intersector(m_indices[i], mask);
+
+                continue;
+            }
+
+            if (negative[node.axis])
+            {
+                stack[stackSize++] = node.offset;
+                stack[stackSize++] = node.offset + 1;
+            }
+            else
+            {
+                stack[stackSize++] = node.offset + 1;
+                stack[stackSize++] = node.offset;
+            }
+        }
+    }
+
+    struct BuildContext;
+
+    /**
+     * @brief Recursively build the node at the given index.
+     *
+     * @param nodeIndex The node to build.
+     * @param begin     The first primitive (in the indices being built) of the node.
+     * @param end       The end of the primitive range of the node.
+     * @param depth     The depth of the node.
+     * @param context   The build shared state.
+     */
+    void buildNode(std::size_t nodeIndex, std::size_t begin, std::size_t end, std::size_t depth, BuildContext& context);
+
+    /**
+     * @brief Compute the statistics of the tree.
+     */
+    void computeStatistics();
+
+    /**
+     * @brief Build the wide hierarchy from the binary one.
+     */
+    void buildWideNodes();
+
+    /**
+     * @brief Recursively collapse an interior node of the binary hierarchy into a wide node.
+     *
+     * The children of the node are replaced by their own children (the biggest one first) until the wide node is
+     * full, then the interior nodes left become wide nodes.
+     *
+     * @param nodeIndex The interior node to collapse.
+     *
+     * @return Returns the index of the wide node.
+     */
+    std::uint32_t collapseNode(std::uint32_t nodeIndex);
+
+    /**
+     * The nodes, the root is the first one.
+     */
+    Buffer<Node> m_nodes;
+
+    /**
+     * The wide hierarchy (computed from m_nodes), the root is the first one.
+     */
+    std::vector<WideNode> m_wideNodes;
+
+    /**
+     * The primitive indices, referenced by the leaves.
+     */
+    Buffer<std::uint32_t> m_indices;
+
+    /**
+     * The statistics of the last build.
+     */
+    Statistics m_statistics;
+};
+
+#endif //H_RAYTRACING_BVH_H
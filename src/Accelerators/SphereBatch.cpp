@@ -0,0 +1,146 @@
+#include "SphereBatch.h"
+
+#include "Utils/Simd.h"
+#include "Utils/Utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * @struct RayData
+     * @brief The components of a ray, read once by SphereBatch::intersect() for every call of the kernel.
+     */
+    struct RayData
+    {
+        double originX;
+        double originY;
+        double originZ;
+        double directionX;
+        double directionY;
+        double directionZ;
+        double tMin;
+        double tMax;
+    };
+
+    /**
+     * @brief Same computation as Sphere::getHit() for WIDTH slots from the given ones, the ray parameter of each
+     * slot is written in t and whether it is a hit (1 or 0) in hits.
+     *
+     * The ray is the same for every slot: a = |direction|^2 is only computed once.
+     */
+    SIMD_CLONES void intersectSlots(const double* centerX,
+                                    const double* centerY,
+                                    const double* centerZ,
+                                    const double* radius2,
+                                    const RayData& ray,
+                                    std::array<double, SphereBatch::WIDTH>& t,
+                                    std::array<std::int64_t, SphereBatch::WIDTH>& hits)
+    {
+        const double originX = ray.originX;
+        const double originY = ray.originY;
+        const double originZ = ray.originZ;
+        const double directionX = ray.directionX;
+        const double directionY = ray.directionY;
+        const double directionZ = ray.directionZ;
+        const double tMin = ray.tMin;
+        const double tMax = ray.tMax;
+
+        const double a = pow2(directionX) + pow2(directionY) + pow2(directionZ);
+
+        for (std::size_t i = 0; i < SphereBatch::WIDTH; i++)
+        {
+            double x = originX - centerX[i];
+            double y = originY - centerY[i];
+            double z = originZ - centerZ[i];
+
+            double b = 2 * (x * directionX + y * directionY + z * directionZ);
+            double c = pow2(x) + pow2(y) + pow2(z) - radius2[i];
+
+            double discriminant = pow2(b) - 4 * a * c;
+            double root = std::sqrt(std::max(discriminant, 0.0));
+
+            double t1 = (-b - root) / (2 * a);
+            double t2 = (-b + root) / (2 * a);
+
+            // The tangent point is kept even behind the origin, like in Sphere::getHit()
+            double hit = t1 > 0 ? t1 : t2;
+            hit = discriminant == 0 ? t1 : hit;
+
+            t[i] = hit;
+            hits[i] = (discriminant >= 0) & ((discriminant == 0) | (hit > 0)) & (hit >= tMin) & (hit <= tMax);
+        }
+    }
+} // namespace
+
+void SphereBatch::add(const Vector3& center, double radius)
+{
+    // The last WIDTH slots are the padding
+    std::size_t slot = size();
+
+    m_centerX.insert(m_centerX.begin() + slot, center.x());
+    m_centerY.insert(m_centerY.begin() + slot, center.y());
+    m_centerZ.insert(m_centerZ.begin() + slot, center.z());
+    m_radius2.insert(m_radius2.begin() + slot, pow2(radius));
+}
+
+void SphereBatch::addEmpty()
+{
+    // A negative squared radius is never hit: by Cauchy-Schwarz the discriminant is then at most -4 * |direction|^2
+    std::size_t slot = size();
+
+    m_centerX.insert(m_centerX.begin() + slot, 0.0);
+    m_centerY.insert(m_centerY.begin() + slot, 0.0);
+    m_centerZ.insert(m_centerZ.begin() + slot, 0.0);
+    m_radius2.insert(m_radius2.begin() + slot, -1.0);
+}
+
+void SphereBatch::clear()
+{
+    m_centerX.assign(WIDTH, 0.0);
+    m_centerY.assign(WIDTH, 0.0);
+    m_centerZ.assign(WIDTH, 0.0);
+    m_radius2.assign(WIDTH, -1.0);
+}
+
+std::size_t SphereBatch::size() const
+{
+    return m_radius2.size() - WIDTH;
+}
+
+std::optional<SphereBatch::Hit> SphereBatch::intersect(const Ray& ray, std::size_t begin, std::size_t count) const
+{
+    const Vector3& origin = ray.getOrigin();
+    const Vector3& direction = ray.getDirection();
+    const RayData rayData{origin.x(),
+                          origin.y(),
+                          origin.z(),
+                          direction.x(),
+                          direction.y(),
+                          direction.z(),
+                          ray.getTMin(),
+                          ray.getTMax()};
+
+    std::optional<Hit> closest;
+
+    std::array<double, WIDTH> t;
+    std::array<std::int64_t, WIDTH> hits;
+
+    for (std::size_t first = begin; first < begin + count; first += WIDTH)
+    {
+        intersectSlots(&m_centerX[first], &m_centerY[first], &m_centerZ[first], &m_radius2[first], rayData, t, hits);
+
+        // The slots after the range may be spheres of other leaves
+        std::size_t slotCount = std::min(WIDTH, begin + count - first);
+        for (std::size_t i = 0; i < slotCount; i++)
+        {
+            if (hits[i] != 0 && (!closest.has_value() || t[i] < closest->t))
+                closest = Hit{t[i], first + i};
+        }
+    }
+
+    return closest;
+}
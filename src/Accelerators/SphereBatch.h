@@ -0,0 +1,95 @@
+#ifndef H_RAYTRACING_SPHEREBATCH_H
+#define H_RAYTRACING_SPHEREBATCH_H
+
+#include "BVH.h"
+#include "Utils/Ray.h"
+#include "Utils/Vector3.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * @class SphereBatch
+ * @brief Spheres stored by coordinate (SoA), intersected WIDTH at a time with a ray.
+ *
+ * The slots follow the order of the primitives of a BVH (see BVH::getIndices()), so that the spheres of a leaf are
+ * next to each other and tested at once (SIMD kernel): a leaf of 8 spheres is one AVX-512 or two AVX2 instructions
+ * per operation. The slots of the other primitives are empty, never hit.
+ *
+ * @see BVH, Sphere
+ */
+class SphereBatch
+{
+public:
+    /**
+     * Number of slots intersected at once (the size of the biggest BVH leaves).
+     */
+    static constexpr std::size_t WIDTH = BVH::MAX_LEAF_SIZE;
+
+    /**
+     * Minimum number of spheres of a leaf worth the kernel: for fewer spheres, Sphere::getHit() is faster since most
+     * of the rays miss and it stops before the square root.
+     */
+    static constexpr std::size_t MIN_SPHERES = 4;
+
+    /**
+     * @struct Hit
+     * @brief The closest sphere hit by a ray.
+     */
+    struct Hit
+    {
+        double t = 0.0;       /*!< The ray parameter of the hit. */
+        std::size_t slot = 0; /*!< The slot of the sphere. */
+    };
+
+    /**
+     * @brief Add a sphere in the next slot.
+     *
+     * @param center The center of the sphere.
+     * @param radius The radius of the sphere.
+     */
+    void add(const Vector3& center, double radius);
+
+    /**
+     * @brief Add an empty slot (a primitive which isn't a sphere).
+     */
+    void addEmpty();
+
+    /**
+     * @brief Remove all the slots.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of slots.
+     *
+     * @return Returns the number of slots (spheres and empty ones).
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Intersect a ray with the spheres of a range of slots.
+     *
+     * Same hits as Sphere::getHit(), in the interval of the ray.
+     *
+     * @param ray   The ray.
+     * @param begin The first slot.
+     * @param count The number of slots.
+     *
+     * @return Returns the closest hit if a sphere of the range is hit, nothing otherwise.
+     */
+    std::optional<Hit> intersect(const Ray& ray, std::size_t begin, std::size_t count) const;
+
+private:
+    /**
+     * The coordinates of the centers and the squared radius of each slot, followed by WIDTH empty slots so that the
+     * kernel always reads WIDTH slots.
+     */
+    std::vector<double> m_centerX = std::vector<double>(WIDTH, 0.0);
+    std::vector<double> m_centerY = std::vector<double>(WIDTH, 0.0);
+    std::vector<double> m_centerZ = std::vector<double>(WIDTH, 0.0);
+    std::vector<double> m_radius2 = std::vector<double>(WIDTH, -1.0);
+};
+
+#endif //H_RAYTRACING_SPHEREBATCH_H
@@ -4,8 +4,17 @@
 /**
  * @brief Enable or disable parallelization.
  *
- * Mainly used in the Scene implementation.
+ * Mainly used in the Scene implementation. Defined by the PARALLELIZATION CMake option (ON by default), uncomment to
+ * force it when building without CMake.
  */
 //#define PARALLELIZATION
 
+/**
+ * @brief Enable or disable the SFML window (Scene::show()).
+ *
+ * Without it, SFML isn't used at all and the images can only be saved as PPM or PNG (see ImageWriter). Defined by the
+ * SFML_VIEWER CMake option (ON by default), uncomment to force it when building without CMake.
+ */
+//#define SFML_VIEWER
+
 #endif //H_RAYTRACING_CONFIG_H
@@ -0,0 +1,452 @@
+#include "ImageWriter.h"
+
+#include "Config.h"
+#include "Utils/Exceptions.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+    /**
+     * The LZ77 parameters of deflate: the distance of the matches (window) and their length.
+     */
+    constexpr std::size_t WINDOW_SIZE = 32768;
+    constexpr std::size_t MIN_MATCH = 3;
+    constexpr std::size_t MAX_MATCH = 258;
+
+    /**
+     * The positions with the same first bytes are chained by a hash table, at most MAX_CHAIN of them are compared.
+     */
+    constexpr std::size_t HASH_SIZE = 1 << 15;
+    constexpr std::size_t MAX_CHAIN = 32;
+
+    /**
+     * The first length (3 to 258) of each length code (257 to 285) and its number of extra bits.
+     */
+    constexpr std::array<std::uint16_t, 29> LENGTH_BASES = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195,
+            227, 258};
+    constexpr std::array<std::uint8_t, 29> LENGTH_EXTRA_BITS = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+    /**
+     * The first distance (1 to 32768) of each distance code (0 to 29) and its number of extra bits.
+     */
+    constexpr std::array<std::uint16_t, 30> DISTANCE_BASES = {
+            1,   2,   3,   4,   5,    7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+            193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    constexpr std::array<std::uint8_t, 30> DISTANCE_EXTRA_BITS = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    /**
+     * @brief The bits of a deflate stream, packed from the least significant bit of each byte.
+     */
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<std::uint8_t>& bytes) : m_bytes(bytes)
+        {
+        }
+
+        /**
+         * @brief Write the count lowest bits of a value, from the least significant one (extra bits, headers).
+         */
+        void write(std::uint32_t value, unsigned int count)
+        {
+            m_buffer |= static_cast<std::uint64_t>(value) << m_count;
+            m_count += count;
+
+            while (m_count >= 8)
+            {
+                m_bytes.push_back(static_cast<std::uint8_t>(m_buffer));
+                m_buffer >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        /**
+         * @brief Write a Huffman code, from its most significant bit.
+         */
+        void writeCode(std::uint32_t code, unsigned int length)
+        {
+            std::uint32_t reversed = 0;
+            for (unsigned int i = 0; i < length; i++)
+                reversed = (reversed << 1) | ((code >> i) & 1);
+
+            write(reversed, length);
+        }
+
+        /**
+         * @brief Write the last bits, completed with zeros up to a byte.
+         */
+        void flush()
+        {
+            if (m_count > 0)
+                m_bytes.push_back(static_cast<std::uint8_t>(m_buffer));
+
+            m_buffer = 0;
+            m_count = 0;
+        }
+
+    private:
+        std::vector<std::uint8_t>& m_bytes;
+        std::uint64_t m_buffer = 0;
+        unsigned int m_count = 0;
+    };
+
+    /**
+     * @brief Write a literal/length symbol (0 to 287) with the fixed Huffman codes of deflate.
+     */
+    void writeSymbol(BitWriter& bits, std::uint32_t symbol)
+    {
+        if (symbol < 144)
+            bits.writeCode(0x30 + symbol, 8);
+        else if (symbol < 256)
+            bits.writeCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280)
+            bits.writeCode(symbol - 256, 7);
+        else
+            bits.writeCode(0xC0 + symbol - 280, 8);
+    }
+
+    /**
+     * @brief Write a match: its length code and distance code, each one followed by its extra bits.
+     */
+    void writeMatch(BitWriter& bits, std::size_t length, std::size_t distance)
+    {
+        std::size_t lengthCode = std::upper_bound(LENGTH_BASES.begin(), LENGTH_BASES.end(), length) -
+                                 LENGTH_BASES.begin() - 1;
+        writeSymbol(bits, static_cast<std::uint32_t>(257 + lengthCode));
+        bits.write(static_cast<std::uint32_t>(length - LENGTH_BASES[lengthCode]), LENGTH_EXTRA_BITS[lengthCode]);
+
+        std::size_t distanceCode = std::upper_bound(DISTANCE_BASES.begin(), DISTANCE_BASES.end(), distance) -
+                                   DISTANCE_BASES.begin() - 1;
+        bits.writeCode(static_cast<std::uint32_t>(distanceCode), 5);
+        bits.write(static_cast<std::uint32_t>(distance - DISTANCE_BASES[distanceCode]),
+                   DISTANCE_EXTRA_BITS[distanceCode]);
+    }
+
+    /**
+     * @brief Compress data as one deflate block with the fixed Huffman codes (LZ77 with hash chains, greedy).
+     */
+    void deflate(const std::vector<std::uint8_t>& data, std::vector<std::uint8_t>& res)
+    {
+        BitWriter bits(res);
+
+        // Last block, fixed Huffman codes
+        bits.write(1, 1);
+        bits.write(1, 2);
+
+        // The last position of each hash, and the previous position of the same hash for each position of the window
+        std::vector<std::int64_t> head(HASH_SIZE, -1);
+        std::vector<std::int64_t> previous(WINDOW_SIZE, -1);
+
+        auto insert = [&](std::size_t position) {
+            if (position + MIN_MATCH > data.size())
+                return;
+
+            std::size_t hash = ((data[position] << 10) ^ (data[position + 1] << 5) ^ data[position + 2]) &
+                               (HASH_SIZE - 1);
+            previous[position % WINDOW_SIZE] = head[hash];
+            head[hash] = static_cast<std::int64_t>(position);
+        };
+
+        std::size_t position = 0;
+        while (position < data.size())
+        {
+            std::size_t bestLength = 0;
+            std::size_t bestDistance = 0;
+
+            if (position + MIN_MATCH <= data.size())
+            {
+                std::size_t hash = ((data[position] << 10) ^ (data[position + 1] << 5) ^ data[position + 2]) &
+                                   (HASH_SIZE - 1);
+                std::size_t maxLength = std::min(MAX_MATCH, data.size() - position);
+
+                std::int64_t candidate = head[hash];
+                for (std::size_t chain = 0; chain < MAX_CHAIN && candidate >= 0; chain++)
+                {
+                    auto start = static_cast<std::size_t>(candidate);
+                    if (position - start > WINDOW_SIZE)
+                        break;
+
+                    std::size_t length = 0;
+                    while (length < maxLength && data[start + length] == data[position + length])
+                        length++;
+
+                    if (length > bestLength)
+                    {
+                        bestLength = length;
+                        bestDistance = position - start;
+
+                        if (length == maxLength)
+                            break;
+                    }
+
+                    candidate = previous[start % WINDOW_SIZE];
+                }
+            }
+
+            if (bestLength >= MIN_MATCH)
+            {
+                writeMatch(bits, bestLength, bestDistance);
+
+                for (std::size_t i = 0; i < bestLength; i++)
+                    insert(position + i);
+                position += bestLength;
+            }
+            else
+            {
+                writeSymbol(bits, data[position]);
+
+                insert(position);
+                position++;
+            }
+        }
+
+        // End of block
+        writeSymbol(bits, 256);
+        bits.flush();
+    }
+
+    std::uint8_t paeth(int left, int up, int upLeft)
+    {
+        int estimate = left + up - upLeft;
+        int distanceLeft = std::abs(estimate - left);
+        int distanceUp = std::abs(estimate - up);
+        int distanceUpLeft = std::abs(estimate - upLeft);
+
+        if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft)
+            return static_cast<std::uint8_t>(left);
+        if (distanceUp <= distanceUpLeft)
+            return static_cast<std::uint8_t>(up);
+
+        return static_cast<std::uint8_t>(upLeft);
+    }
+
+    /**
+     * @brief Filter the rows of RGB pixels, each row starting with its filter type.
+     *
+     * Each row uses the filter (none, sub, up, average or Paeth) with the smallest sum of the absolute differences,
+     * the usual heuristic: the smaller the differences, the better the compression.
+     */
+    std::vector<std::uint8_t> filterRows(std::size_t width, std::size_t height, const std::vector<std::uint8_t>& pixels)
+    {
+        constexpr std::size_t PIXEL_SIZE = 3;
+        constexpr std::uint8_t FILTER_COUNT = 5;
+
+        std::size_t rowSize = width * PIXEL_SIZE;
+        std::vector<std::uint8_t> res;
+        res.reserve(height * (rowSize + 1));
+
+        std::vector<std::uint8_t> filtered(rowSize);
+        std::vector<std::uint8_t> best(rowSize);
+        for (std::size_t y = 0; y < height; y++)
+        {
+            const std::uint8_t* row = pixels.data() + y * rowSize;
+            const std::uint8_t* priorRow = y > 0 ? row - rowSize : nullptr;
+
+            std::uint8_t bestFilter = 0;
+            std::size_t bestCost = 0;
+            for (std::uint8_t filter = 0; filter < FILTER_COUNT; filter++)
+            {
+                std::size_t cost = 0;
+                for (std::size_t i = 0; i < rowSize; i++)
+                {
+                    int left = i >= PIXEL_SIZE ? row[i - PIXEL_SIZE] : 0;
+                    int up = priorRow != nullptr ? priorRow[i] : 0;
+                    int upLeft = priorRow != nullptr && i >= PIXEL_SIZE ? priorRow[i - PIXEL_SIZE] : 0;
+
+                    int prediction = 0;
+                    if (filter == 1)
+                        prediction = left;
+                    else if (filter == 2)
+                        prediction = up;
+                    else if (filter == 3)
+                        prediction = (left + up) / 2;
+                    else if (filter == 4)
+                        prediction = paeth(left, up, upLeft);
+
+                    filtered[i] = static_cast<std::uint8_t>(row[i] - prediction);
+                    cost += static_cast<std::size_t>(std::abs(static_cast<std::int8_t>(filtered[i])));
+                }
+
+                if (filter == 0 || cost < bestCost)
+                {
+                    bestFilter = filter;
+                    bestCost = cost;
+                    best.swap(filtered);
+                }
+            }
+
+            res.push_back(bestFilter);
+            res.insert(res.end(), best.begin(), best.end());
+        }
+
+        return res;
+    }
+
+    std::string getExtension(const std::string& path)
+    {
+        std::size_t dot = path.rfind('.');
+        if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos)
+            return "";
+
+        std::string res = path.substr(dot + 1);
+        std::transform(res.begin(), res.end(), res.begin(), [](unsigned char character) {
+            return static_cast<char>(std::tolower(character));
+        });
+
+        return res;
+    }
+
+    std::ofstream openFile(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            throw Exception::Loader::CantWriteFile(path);
+
+        return file;
+    }
+
+    void closeFile(std::ofstream& file, const std::string& path)
+    {
+        file.close();
+        if (!file)
+            throw Exception::Loader::CantWriteFile(path);
+    }
+
+    std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0)
+    {
+        static const auto table = [] {
+            std::array<std::uint32_t, 256> res{};
+            for (std::uint32_t i = 0; i < 256; i++)
+            {
+                std::uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++)
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                res[i] = value;
+            }
+            return res;
+        }();
+
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; i++)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+        return ~crc;
+    }
+
+    std::uint32_t adler32(const std::vector<std::uint8_t>& data)
+    {
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        for (std::uint8_t value : data)
+        {
+            a = (a + value) % 65521;
+            b = (b + a) % 65521;
+        }
+
+        return (b << 16) | a;
+    }
+
+    void pushBigEndian(std::vector<std::uint8_t>& bytes, std::uint32_t value)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value >> 24));
+        bytes.push_back(static_cast<std::uint8_t>(value >> 16));
+        bytes.push_back(static_cast<std::uint8_t>(value >> 8));
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    /**
+     * @brief Write a PNG chunk (length, type, data and CRC of the type and data).
+     */
+    void writeChunk(std::ofstream& file, const char* type, const std::vector<std::uint8_t>& data)
+    {
+        std::vector<std::uint8_t> chunk;
+        chunk.reserve(data.size() + 12);
+
+        pushBigEndian(chunk, static_cast<std::uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        pushBigEndian(chunk, crc32(chunk.data() + 4, data.size() + 4));
+
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    }
+} // namespace
+
+bool ImageWriter::isSupported(const std::string& path)
+{
+    std::string extension = getExtension(path);
+
+#ifdef SFML_VIEWER
+    if (extension == "bmp" || extension == "tga" || extension == "jpg" || extension == "jpeg")
+        return true;
+#endif
+
+    return extension == "ppm" || extension == "png";
+}
+
+void ImageWriter::write(const std::string& path, const Framebuffer& framebuffer)
+{
+    if (!isSupported(path))
+        throw Exception::Loader::UnsupportedFormat(path);
+
+    std::string extension = getExtension(path);
+
+    if (extension == "ppm")
+        writePPM(path, framebuffer.width(), framebuffer.height(), framebuffer.toRGB());
+    else if (extension == "png")
+        writePNG(path, framebuffer.width(), framebuffer.height(), framebuffer.toRGB());
+#ifdef SFML_VIEWER
+    else if (!framebuffer.toImage().saveToFile(path))
+        throw Exception::Loader::CantWriteFile(path);
+#endif
+}
+
+void ImageWriter::writePPM(const std::string& path,
+                           std::size_t width,
+                           std::size_t height,
+                           const std::vector<std::uint8_t>& pixels)
+{
+    std::ofstream file = openFile(path);
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(width * height * 3));
+
+    closeFile(file, path);
+}
+
+void ImageWriter::writePNG(const std::string& path,
+                           std::size_t width,
+                           std::size_t height,
+                           const std::vector<std::uint8_t>& pixels)
+{
+    std::ofstream file = openFile(path);
+
+    const std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    // 8 bits RGB, not interlaced
+    std::vector<std::uint8_t> header;
+    pushBigEndian(header, static_cast<std::uint32_t>(width));
+    pushBigEndian(header, static_cast<std::uint32_t>(height));
+    header.insert(header.end(), {8, 2, 0, 0, 0});
+    writeChunk(file, "IHDR", header);
+
+    std::vector<std::uint8_t> rows = filterRows(width, height, pixels);
+
+    // Zlib stream (deflate, 32K window) of the filtered rows
+    std::vector<std::uint8_t> data = {0x78, 0x01};
+    deflate(rows, data);
+    pushBigEndian(data, adler32(rows));
+
+    writeChunk(file, "IDAT", data);
+    writeChunk(file, "IEND", {});
+
+    closeFile(file, path);
+}
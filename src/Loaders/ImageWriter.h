@@ -0,0 +1,69 @@
+#ifndef H_RAYTRACING_IMAGEWRITER_H
+#define H_RAYTRACING_IMAGEWRITER_H
+
+#include "Utils/Framebuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ImageWriter
+ * @brief Save the rendered images.
+ *
+ * The PPM (binary) and PNG formats are written without any library, the same way with or without SFML_VIEWER (see
+ * Config.h), so an image can be saved on a machine without window system. The PNG files are compressed (filtered
+ * rows, deflate with the fixed Huffman codes). When built with SFML_VIEWER, SFML also writes the BMP, TGA and JPG
+ * formats.
+ *
+ * @see Framebuffer
+ */
+class ImageWriter
+{
+public:
+    /**
+     * @brief Know if an image can be saved in the format of the extension of a path.
+     *
+     * @param path The path of the image.
+     *
+     * @return Returns true for PPM and PNG (and BMP, TGA and JPG with SFML_VIEWER), false otherwise.
+     */
+    static bool isSupported(const std::string& path);
+
+    /**
+     * @brief Save an image, in the format of the extension of the path (see isSupported()).
+     *
+     * @param path        The path of the image.
+     * @param framebuffer The image.
+     */
+    static void write(const std::string& path, const Framebuffer& framebuffer);
+
+    /**
+     * @brief Save an image as binary PPM (P6).
+     *
+     * @param path   The path of the image.
+     * @param width  The width of the image.
+     * @param height The height of the image.
+     * @param pixels The RGB pixels, row by row.
+     */
+    static void writePPM(const std::string& path,
+                         std::size_t width,
+                         std::size_t height,
+                         const std::vector<std::uint8_t>& pixels);
+
+    /**
+     * @brief Save an image as PNG.
+     *
+     * @param path   The path of the image.
+     * @param width  The width of the image.
+     * @param height The height of the image.
+     * @param pixels The RGB pixels, row by row.
+     */
+    static void writePNG(const std::string& path,
+                         std::size_t width,
+                         std::size_t height,
+                         const std::vector<std::uint8_t>& pixels);
+};
+
+#endif //H_RAYTRACING_IMAGEWRITER_H
@@ -0,0 +1,120 @@
+#include "MappedFile.h"
+
+#include "Utils/Exceptions.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw Exception::Loader::CantOpenFile(path);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw Exception::Loader::CantOpenFile(path);
+    }
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+    // A file of size 0 can't be mapped
+    if (m_size != 0)
+    {
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping != nullptr)
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (m_data == nullptr)
+        {
+            if (m_mapping != nullptr)
+                CloseHandle(m_mapping);
+
+            CloseHandle(file);
+            throw Exception::Loader::CantOpenFile(path);
+        }
+    }
+
+    // The mapping keeps the file open
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file == -1)
+        throw Exception::Loader::CantOpenFile(path);
+
+    struct stat status
+    {
+    };
+    if (fstat(file, &status) == -1)
+    {
+        close(file);
+        throw Exception::Loader::CantOpenFile(path);
+    }
+
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    // A file of size 0 can't be mapped
+    if (m_size != 0)
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file);
+            throw Exception::Loader::CantOpenFile(path);
+        }
+
+        // Read from the start to the end
+        madvise(data, m_size, MADV_SEQUENTIAL);
+
+        m_data = static_cast<const char*>(data);
+    }
+
+    // The mapping keeps the file open
+    close(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<char*>(m_data), m_size);
+}
+
+#endif
+
+std::string_view MappedFile::getContent() const
+{
+    return std::string_view(m_data, m_size);
+}
@@ -0,0 +1,55 @@
+#ifndef H_RAYTRACING_MAPPEDFILE_H
+#define H_RAYTRACING_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The content is paged in by the system on access, so a big file is never copied in a buffer. The mapping is
+ * released at destruction.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Map a file.
+     *
+     * @param path The path of the file.
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Get the content of the file.
+     *
+     * @return Returns the content of the file (valid as long as the mapping).
+     */
+    std::string_view getContent() const;
+
+private:
+    /**
+     * The mapped content (nullptr for an empty file).
+     */
+    const char* m_data = nullptr;
+
+    /**
+     * The size of the file.
+     */
+    std::size_t m_size = 0;
+
+#ifdef _WIN32
+    /**
+     * The file mapping handle.
+     */
+    void* m_mapping = nullptr;
+#endif
+};
+
+#endif //H_RAYTRACING_MAPPEDFILE_H
@@ -0,0 +1,285 @@
+#include "MeshCache.h"
+
+#include "MappedFile.h"
+#include "ObjParser.h"
+#include "Utils/Exceptions.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+    constexpr std::array<char, 8> MAGIC = {'R', 'T', 'M', 'E', 'S', 'H', '\0', '\0'};
+
+    /**
+     * Written in the native byte order, to detect a file written on another architecture.
+     */
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /**
+     * @brief An array of the file.
+     */
+    struct Section
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t count = 0;
+    };
+
+    enum SectionIndex
+    {
+        POSITIONS,
+        NORMALS,
+        INDEXES,
+        NORMAL_INDEXES,
+        BVH_NODES,
+        BVH_INDICES,
+        SECTION_COUNT
+    };
+
+    /**
+     * @brief The header of the file, followed by the sections.
+     */
+    struct Header
+    {
+        std::array<char, 8> magic{};
+        std::uint32_t version = 0;
+        std::uint32_t byteOrderMark = 0;
+        std::uint32_t vectorSize = 0;
+        std::uint32_t nodeSize = 0;
+        std::uint64_t sourceSize = 0;
+        std::int64_t sourceTime = 0;
+        std::uint64_t sourceHash = 0;
+        std::uint64_t primitiveCount = 0;
+        std::uint64_t nodeCount = 0;
+        std::uint64_t leafCount = 0;
+        std::uint64_t depth = 0;
+        double sahCost = 0.0;
+        std::array<Section, SECTION_COUNT> sections{};
+    };
+
+    static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Vector3> &&
+                          std::is_trivially_copyable_v<BVH::Node>,
+                  "The cached types must be trivially copyable.");
+
+    std::uint64_t align(std::uint64_t offset)
+    {
+        return (offset + MeshCache::ALIGNMENT - 1) / MeshCache::ALIGNMENT * MeshCache::ALIGNMENT;
+    }
+
+    /**
+     * @brief Use a section of the mapped file in place.
+     */
+    template<typename T>
+    std::optional<Buffer<T>> view(const std::shared_ptr<MappedFile>& file, const Section& section)
+    {
+        std::string_view content = file->getContent();
+
+        if (section.offset % alignof(T) != 0 || section.offset > content.size() ||
+            section.count > (content.size() - section.offset) / sizeof(T))
+            return std::nullopt;
+
+        const auto* data = reinterpret_cast<const T*>(content.data() + section.offset);
+
+        return Buffer<T>(data, static_cast<std::size_t>(section.count), file);
+    }
+
+    /**
+     * @brief Get a temporary path beside a file, unique to the caller: a random suffix, so that two processes (or
+     * threads) writing the same cache never write the same temporary file.
+     */
+    std::string getTemporaryPath(const std::string& path)
+    {
+        std::random_device device;
+        std::uint64_t suffix = (static_cast<std::uint64_t>(device()) << 32) | device();
+
+        std::ostringstream stream;
+        stream << path << "." << std::hex << std::setw(16) << std::setfill('0') << suffix << ".tmp";
+
+        return stream.str();
+    }
+
+    template<typename T>
+    void writeSection(std::ofstream& file, const Section& section, const Buffer<T>& buffer)
+    {
+        // Padding up to the aligned offset
+        static const std::array<char, MeshCache::ALIGNMENT> zeros{};
+        auto padding = static_cast<std::streamsize>(section.offset) - static_cast<std::streamsize>(file.tellp());
+        file.write(zeros.data(), padding);
+
+        file.write(reinterpret_cast<const char*>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+    }
+} // namespace
+
+std::uint64_t MeshCache::hash(std::string_view data)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (char character : data)
+    {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+std::string MeshCache::getPath(const std::string& sourcePath)
+{
+    return sourcePath + ".cache";
+}
+
+std::optional<MeshCache::Content> MeshCache::read(const std::string& path,
+                                                  const Key& key,
+                                                  const std::function<std::uint64_t()>& sourceHash)
+{
+    std::shared_ptr<MappedFile> file;
+    try
+    {
+        file = std::make_shared<MappedFile>(path);
+    }
+    catch (const Exception::Loader::CantOpenFile&)
+    {
+        return std::nullopt;
+    }
+
+    std::string_view data = file->getContent();
+    if (data.size() < sizeof(Header))
+        return std::nullopt;
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(Header));
+
+    if (header.magic != MAGIC || header.version != VERSION || header.byteOrderMark != BYTE_ORDER_MARK ||
+        header.vectorSize != sizeof(Vector3) || header.nodeSize != sizeof(BVH::Node) ||
+        header.sourceSize != key.sourceSize)
+        return std::nullopt;
+
+    // The content is only hashed if the source was touched
+    if (header.sourceTime != key.sourceTime && header.sourceHash != sourceHash())
+        return std::nullopt;
+
+    auto positions = view<Vector3>(file, header.sections[POSITIONS]);
+    auto normals = view<Vector3>(file, header.sections[NORMALS]);
+    auto indexes = view<std::uint32_t>(file, header.sections[INDEXES]);
+    auto normalIndexes = view<std::uint32_t>(file, header.sections[NORMAL_INDEXES]);
+    auto nodes = view<BVH::Node>(file, header.sections[BVH_NODES]);
+    auto indices = view<std::uint32_t>(file, header.sections[BVH_INDICES]);
+
+    if (!positions || !normals || !indexes || !normalIndexes || !nodes || !indices)
+        return std::nullopt;
+
+    std::size_t triangleCount = indexes->size() / 3;
+    if (indexes->size() % 3 != 0 || normalIndexes->size() != triangleCount || indices->size() != triangleCount ||
+        nodes->empty() != (triangleCount == 0))
+        return std::nullopt;
+
+    // A damaged file is a cache miss, never an access out of the arrays
+    std::size_t positionCount = positions->size();
+    std::size_t normalCount = normals->size();
+    if (!std::all_of(indexes->begin(), indexes->end(), [positionCount](std::uint32_t index) {
+            return index < positionCount;
+        }) ||
+        !std::all_of(normalIndexes->begin(), normalIndexes->end(), [normalCount](std::uint32_t index) {
+            return index == ObjMesh::NO_INDEX || index < normalCount;
+        }) ||
+        !BVH::isValid(*nodes, *indices, triangleCount))
+        return std::nullopt;
+
+    BVH::Statistics statistics;
+    statistics.primitiveCount = static_cast<std::size_t>(header.primitiveCount);
+    statistics.nodeCount = static_cast<std::size_t>(header.nodeCount);
+    statistics.leafCount = static_cast<std::size_t>(header.leafCount);
+    statistics.depth = static_cast<std::size_t>(header.depth);
+    statistics.sahCost = header.sahCost;
+
+    Content content;
+    content.positions = std::move(*positions);
+    content.normals = std::move(*normals);
+    content.indexes = std::move(*indexes);
+    content.normalIndexes = std::move(*normalIndexes);
+    content.bvh.assign(std::move(*nodes), std::move(*indices), statistics);
+
+    return content;
+}
+
+bool MeshCache::write(const std::string& path, const Key& key, const Content& content)
+{
+    const BVH::Statistics& statistics = content.bvh.getStatistics();
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.vectorSize = sizeof(Vector3);
+    header.nodeSize = sizeof(BVH::Node);
+    header.sourceSize = key.sourceSize;
+    header.sourceTime = key.sourceTime;
+    header.sourceHash = key.sourceHash;
+    header.primitiveCount = statistics.primitiveCount;
+    header.nodeCount = statistics.nodeCount;
+    header.leafCount = statistics.leafCount;
+    header.depth = statistics.depth;
+    header.sahCost = statistics.sahCost;
+
+    std::array<std::pair<std::size_t, std::size_t>, SECTION_COUNT> sizes = {{
+            {content.positions.size(), sizeof(Vector3)},
+            {content.normals.size(), sizeof(Vector3)},
+            {content.indexes.size(), sizeof(std::uint32_t)},
+            {content.normalIndexes.size(), sizeof(std::uint32_t)},
+            {content.bvh.getNodes().size(), sizeof(BVH::Node)},
+            {content.bvh.getIndices().size(), sizeof(std::uint32_t)},
+    }};
+
+    std::uint64_t offset = align(sizeof(Header));
+    for (std::size_t i = 0; i < SECTION_COUNT; i++)
+    {
+        header.sections[i] = {offset, sizes[i].first};
+        offset = align(offset + sizes[i].first * sizes[i].second);
+    }
+
+    std::string temporaryPath = getTemporaryPath(path);
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        writeSection(file, header.sections[POSITIONS], content.positions);
+        writeSection(file, header.sections[NORMALS], content.normals);
+        writeSection(file, header.sections[INDEXES], content.indexes);
+        writeSection(file, header.sections[NORMAL_INDEXES], content.normalIndexes);
+        writeSection(file, header.sections[BVH_NODES], content.bvh.getNodes());
+        writeSection(file, header.sections[BVH_INDICES], content.bvh.getIndices());
+
+        if (!file)
+        {
+            file.close();
+
+            std::error_code error;
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+
+    // Replaces an existing cache at once: a reader maps either the previous file or the new one
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,117 @@
+#ifndef H_RAYTRACING_MESHCACHE_H
+#define H_RAYTRACING_MESHCACHE_H
+
+#include "Accelerators/BVH.h"
+#include "Utils/Buffer.h"
+#include "Utils/Vector3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MeshCache
+ * @brief Binary cache of a mesh and of its BVH.
+ *
+ * The file holds a header followed by the raw arrays (vertices, indexes, BVH nodes), each one aligned on
+ * MeshCache::ALIGNMENT. It is memory-mapped when read and the arrays are used in place: loading a mesh from its
+ * cache only checks the header.
+ *
+ * The mesh is cached in its object space (the models place it with their own transform), so a cache is valid for a
+ * given key: the size and the modification time of the source file, which are cheap to get. When only the time
+ * differs (like after a checkout), the hash of the source content decides. The version is increased every time the
+ * layout of the file (or of the cached types) changes.
+ *
+ * @see Mesh, MappedFile
+ */
+class MeshCache
+{
+public:
+    /**
+     * Version of the file layout.
+     */
+    static constexpr std::uint32_t VERSION = 1;
+
+    /**
+     * Alignment of the arrays in the file.
+     */
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    /**
+     * @struct Key
+     * @brief What the cached mesh depends on.
+     */
+    struct Key
+    {
+        std::uint64_t sourceSize = 0; /*!< Size of the source file. */
+        std::int64_t sourceTime = 0;  /*!< Modification time of the source file (in ticks of its clock). */
+        std::uint64_t sourceHash = 0; /*!< Hash of the source file content (see hash()). */
+    };
+
+    /**
+     * @struct Content
+     * @brief The cached data of a model.
+     */
+    struct Content
+    {
+        Buffer<Vector3> positions;           /*!< The vertex positions. */
+        Buffer<Vector3> normals;             /*!< The normals. */
+        Buffer<std::uint32_t> indexes;       /*!< The vertex indexes, 3 per triangle. */
+        Buffer<std::uint32_t> normalIndexes; /*!< The normal index of each triangle. */
+        BVH bvh;                             /*!< The hierarchy over the triangles. */
+    };
+
+    /**
+     * @brief Hash some data (64 bits FNV-1a).
+     *
+     * @param data The data to hash.
+     *
+     * @return Returns the hash.
+     */
+    static std::uint64_t hash(std::string_view data);
+
+    /**
+     * @brief Get the path of the cache file of a source file.
+     *
+     * The cache file is written beside the source file.
+     *
+     * @param sourcePath The path of the source file.
+     *
+     * @return Returns the path of the cache file.
+     */
+    static std::string getPath(const std::string& sourcePath);
+
+
+    /**
+     * @brief Read a cache file.
+     *
+     * @param path       The path of the cache file.
+     * @param key        The expected size and time of the source (its hash isn't used).
+     * @param sourceHash Computes the hash of the source, only called if the size matches but not the time.
+     *
+     * @return Returns the content (viewing the mapped file) if the file exists and matches the key and the version,
+     * nothing otherwise.
+     */
+    static std::optional<Content> read(const std::string& path,
+                                       const Key& key,
+                                       const std::function<std::uint64_t()>& sourceHash);
+
+    /**
+     * @brief Write a cache file.
+     *
+     * The file is written under a unique temporary name then renamed over the cache file, so that an interrupted (or
+     * concurrent) write never leaves a broken cache file.
+     *
+     * @param path    The path of the cache file.
+     * @param key     The key of the cache.
+     * @param content The content to write.
+     *
+     * @return Returns true if the file was written.
+     */
+    static bool write(const std::string& path, const Key& key, const Content& content);
+};
+
+#endif //H_RAYTRACING_MESHCACHE_H
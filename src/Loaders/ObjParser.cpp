@@ -0,0 +1,415 @@
+#include "ObjParser.h"
+
+#include "MappedFile.h"
+#include "Utils/Exceptions.h"
+#include "Utils/Parallel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief A vertex of a face, with resolved indexes.
+     */
+    struct FaceVertex
+    {
+        std::uint32_t position = ObjMesh::NO_INDEX;
+        std::uint32_t texture = ObjMesh::NO_INDEX;
+        std::uint32_t normal = ObjMesh::NO_INDEX;
+    };
+
+    bool isBlank(char character)
+    {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    const char* skipBlanks(const char* it, const char* end)
+    {
+        while (it != end && isBlank(*it))
+            it++;
+
+        return it;
+    }
+
+    Exception::Loader::ParseError parseError(const std::string& message, std::size_t line)
+    {
+        return Exception::Loader::ParseError(message + " (line " + std::to_string(line) + ").");
+    }
+
+    double readDouble(const char*& it, const char* end, std::size_t line)
+    {
+        it = skipBlanks(it, end);
+
+        // std::from_chars doesn't accept an explicit plus sign
+        if (it != end && *it == '+')
+            it++;
+
+        double value = 0.0;
+        auto [next, error] = std::from_chars(it, end, value);
+        if (error != std::errc())
+            throw parseError("Wrong number", line);
+
+        it = next;
+
+        return value;
+    }
+
+    std::uint32_t readIndex(const char*& it, const char* end, std::size_t count, std::size_t line)
+    {
+        long long index = 0;
+        auto [next, error] = std::from_chars(it, end, index);
+        if (error != std::errc())
+            throw parseError("Wrong index", line);
+
+        it = next;
+
+        // 1-based, or relative to the end of the list if negative
+        long long resolved = index > 0 ? index - 1 : static_cast<long long>(count) + index;
+        if (index == 0 || resolved < 0 || resolved >= static_cast<long long>(count))
+            throw parseError("Index out of range", line);
+
+        return static_cast<std::uint32_t>(resolved);
+    }
+
+    /**
+     * @brief The elements handled by the parser.
+     */
+    enum class Element
+    {
+        POSITION,
+        TEXTURE_COORDINATES,
+        NORMAL,
+        FACE,
+        OTHER
+    };
+
+    bool isKeyword(const char* it, const char* end, std::string_view keyword)
+    {
+        auto length = static_cast<std::size_t>(end - it);
+
+        return length > keyword.size() && std::memcmp(it, keyword.data(), keyword.size()) == 0 &&
+               isBlank(it[keyword.size()]);
+    }
+
+    /**
+     * @brief Get the element of a line, and move after its keyword.
+     */
+    Element readElement(const char*& it, const char* lineEnd)
+    {
+        it = skipBlanks(it, lineEnd);
+
+        if (isKeyword(it, lineEnd, "v"))
+        {
+            it += 1;
+            return Element::POSITION;
+        }
+
+        if (isKeyword(it, lineEnd, "vt"))
+        {
+            it += 2;
+            return Element::TEXTURE_COORDINATES;
+        }
+
+        if (isKeyword(it, lineEnd, "vn"))
+        {
+            it += 2;
+            return Element::NORMAL;
+        }
+
+        if (isKeyword(it, lineEnd, "f"))
+        {
+            it += 1;
+            return Element::FACE;
+        }
+
+        return Element::OTHER;
+    }
+
+    const char* findLineEnd(const char* it, const char* end)
+    {
+        const auto* lineEnd = static_cast<const char*>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+
+        return lineEnd == nullptr ? end : lineEnd;
+    }
+
+    /**
+     * @brief Number of lines and of each vertex element.
+     */
+    struct Counts
+    {
+        std::size_t lines = 0;
+        std::size_t positions = 0;
+        std::size_t textureCoordinates = 0;
+        std::size_t normals = 0;
+    };
+
+    /**
+     * @brief A part of the file, starting and ending on a line boundary.
+     */
+    struct Chunk
+    {
+        std::string_view text;
+
+        /**
+         * The elements of this chunk.
+         */
+        Counts counts;
+
+        /**
+         * The elements of all the previous chunks: the position of this chunk in the mesh arrays.
+         */
+        Counts offsets;
+
+        /**
+         * The triangles of this chunk (indexes in the whole mesh), appended to the mesh at the end.
+         */
+        std::vector<std::uint32_t> positionIndexes;
+        std::vector<std::uint32_t> textureIndexes;
+        std::vector<std::uint32_t> normalIndexes;
+    };
+
+    /**
+     * @brief First pass, only count the lines and the vertex elements of a chunk.
+     */
+    void countChunk(Chunk& chunk)
+    {
+        const char* it = chunk.text.data();
+        const char* end = chunk.text.data() + chunk.text.size();
+
+        while (it < end)
+        {
+            const char* lineEnd = findLineEnd(it, end);
+
+            switch (readElement(it, lineEnd))
+            {
+                case Element::POSITION:
+                    chunk.counts.positions++;
+                    break;
+                case Element::TEXTURE_COORDINATES:
+                    chunk.counts.textureCoordinates++;
+                    break;
+                case Element::NORMAL:
+                    chunk.counts.normals++;
+                    break;
+                default:
+                    break;
+            }
+
+            chunk.counts.lines++;
+            it = lineEnd == end ? end : lineEnd + 1;
+        }
+    }
+
+    /**
+     * @brief Store a vertex element at its place in the mesh array.
+     *
+     * The array is already sized when there are several chunks, and filled as the file is read otherwise.
+     */
+    template<typename T>
+    void store(std::vector<T>& elements, std::size_t index, const T& element)
+    {
+        if (index < elements.size())
+            elements[index] = element;
+        else
+            elements.push_back(element);
+    }
+
+    /**
+     * @brief Second pass, parse a chunk.
+     *
+     * The vertex elements are written at their final place in the mesh arrays, the triangles are stored in the
+     * chunk. Thanks to the offsets, the indexes (even the negative ones) are resolved like if the file
+     * was parsed from the start.
+     */
+    void parseChunk(Chunk& chunk, ObjMesh& mesh)
+    {
+        Counts counts = chunk.offsets;
+
+        // Reused for every face
+        std::vector<FaceVertex> face;
+
+        const char* it = chunk.text.data();
+        const char* end = chunk.text.data() + chunk.text.size();
+
+        while (it < end)
+        {
+            const char* lineEnd = findLineEnd(it, end);
+            std::size_t line = ++counts.lines;
+
+            switch (readElement(it, lineEnd))
+            {
+                case Element::POSITION:
+                {
+                    double x = readDouble(it, lineEnd, line);
+                    double y = readDouble(it, lineEnd, line);
+                    double z = readDouble(it, lineEnd, line);
+
+                    store(mesh.positions, counts.positions++, Vector3(x, y, z));
+                    break;
+                }
+                case Element::TEXTURE_COORDINATES:
+                {
+                    double u = readDouble(it, lineEnd, line);
+
+                    // v is optional
+                    double v = 0.0;
+                    if (skipBlanks(it, lineEnd) != lineEnd)
+                        v = readDouble(it, lineEnd, line);
+
+                    store(mesh.textureCoordinates, counts.textureCoordinates++, {u, v});
+                    break;
+                }
+                case Element::NORMAL:
+                {
+                    double x = readDouble(it, lineEnd, line);
+                    double y = readDouble(it, lineEnd, line);
+                    double z = readDouble(it, lineEnd, line);
+
+                    store(mesh.normals, counts.normals++, Vector3(x, y, z));
+                    break;
+                }
+                case Element::FACE:
+                {
+                    face.clear();
+
+                    for (it = skipBlanks(it, lineEnd); it != lineEnd && *it != '#'; it = skipBlanks(it, lineEnd))
+                    {
+                        // v, v/vt, v//vn or v/vt/vn
+                        FaceVertex vertex;
+                        vertex.position = readIndex(it, lineEnd, counts.positions, line);
+
+                        if (it != lineEnd && *it == '/')
+                        {
+                            it++;
+                            if (it != lineEnd && *it != '/')
+                                vertex.texture = readIndex(it, lineEnd, counts.textureCoordinates, line);
+
+                            if (it != lineEnd && *it == '/')
+                            {
+                                it++;
+                                vertex.normal = readIndex(it, lineEnd, counts.normals, line);
+                            }
+                        }
+
+                        if (it != lineEnd && !isBlank(*it))
+                            throw parseError("Wrong face vertex", line);
+
+                        face.push_back(vertex);
+                    }
+
+                    if (face.size() < 3)
+                        throw parseError("A face needs at least 3 vertices", line);
+
+                    // Fan triangulation
+                    for (std::size_t i = 1; i + 1 < face.size(); i++)
+                    {
+                        for (const auto& vertex : {face[0], face[i], face[i + 1]})
+                        {
+                            chunk.positionIndexes.push_back(vertex.position);
+                            chunk.textureIndexes.push_back(vertex.texture);
+                            chunk.normalIndexes.push_back(vertex.normal);
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            // Other elements (and the end of the handled ones, like the 'w' coordinate) are ignored
+            it = lineEnd == end ? end : lineEnd + 1;
+        }
+    }
+
+    void append(std::vector<std::uint32_t>& destination, const std::vector<std::uint32_t>& source, std::size_t offset)
+    {
+        std::copy(source.begin(), source.end(), destination.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+} // namespace
+
+ObjMesh ObjParser::read(const std::string& path, std::size_t threadCount)
+{
+    MappedFile file(path);
+
+    return parse(file.getContent(), threadCount);
+}
+
+ObjMesh ObjParser::parse(std::string_view text, std::size_t threadCount)
+{
+    // Split the text in chunks of about the same size, on line boundaries
+    std::size_t chunkCount = std::clamp<std::size_t>(text.size() / MIN_CHUNK_SIZE, 1, resolveThreadCount(threadCount));
+
+    std::vector<Chunk> chunks(chunkCount);
+
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < chunkCount; i++)
+    {
+        std::size_t chunkEnd = text.size();
+        if (i + 1 < chunkCount)
+        {
+            chunkEnd = text.find('\n', std::max(start, (i + 1) * text.size() / chunkCount));
+            chunkEnd = chunkEnd == std::string_view::npos ? text.size() : chunkEnd + 1;
+        }
+
+        chunks[i].text = text.substr(start, chunkEnd - start);
+        start = chunkEnd;
+    }
+
+    ObjMesh mesh;
+
+    // First pass to know where each chunk writes in the mesh (not needed with only one chunk)
+    if (chunkCount > 1)
+    {
+        parallelFor(chunkCount, chunkCount, [&](std::size_t i) { countChunk(chunks[i]); });
+
+        Counts total;
+        for (auto& chunk : chunks)
+        {
+            chunk.offsets = total;
+
+            total.lines += chunk.counts.lines;
+            total.positions += chunk.counts.positions;
+            total.textureCoordinates += chunk.counts.textureCoordinates;
+            total.normals += chunk.counts.normals;
+        }
+
+        mesh.positions.resize(total.positions);
+        mesh.textureCoordinates.resize(total.textureCoordinates);
+        mesh.normals.resize(total.normals);
+    }
+
+    parallelFor(chunkCount, chunkCount, [&](std::size_t i) { parseChunk(chunks[i], mesh); });
+
+    if (std::max({mesh.positions.size(), mesh.textureCoordinates.size(), mesh.normals.size()}) >= ObjMesh::NO_INDEX)
+        throw Exception::Loader::ParseError("Too many vertices.");
+
+    if (chunkCount == 1)
+    {
+        mesh.positionIndexes = std::move(chunks[0].positionIndexes);
+        mesh.textureIndexes = std::move(chunks[0].textureIndexes);
+        mesh.normalIndexes = std::move(chunks[0].normalIndexes);
+
+        return mesh;
+    }
+
+    // Stitch the triangles of the chunks
+    std::vector<std::size_t> indexOffsets(chunkCount + 1, 0);
+    for (std::size_t i = 0; i < chunkCount; i++)
+        indexOffsets[i + 1] = indexOffsets[i] + chunks[i].positionIndexes.size();
+
+    mesh.positionIndexes.resize(indexOffsets.back());
+    mesh.textureIndexes.resize(indexOffsets.back());
+    mesh.normalIndexes.resize(indexOffsets.back());
+
+    parallelFor(chunkCount, chunkCount, [&](std::size_t i) {
+        append(mesh.positionIndexes, chunks[i].positionIndexes, indexOffsets[i]);
+        append(mesh.textureIndexes, chunks[i].textureIndexes, indexOffsets[i]);
+        append(mesh.normalIndexes, chunks[i].normalIndexes, indexOffsets[i]);
+    });
+
+    return mesh;
+}
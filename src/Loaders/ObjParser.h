@@ -0,0 +1,115 @@
+#ifndef H_RAYTRACING_OBJPARSER_H
+#define H_RAYTRACING_OBJPARSER_H
+
+#include "Utils/Vector3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct ObjMesh
+ * @brief The geometry read from a Wavefront OBJ file.
+ *
+ * The faces are triangulated: every triangle is stored as 3 consecutive entries of the index buffers. The indexes are
+ * 0-based and already resolved (the negative OBJ indexes are relative to the end of the list at the face line).
+ *
+ * @see ObjParser
+ */
+struct ObjMesh
+{
+    /**
+     * Index used when a face vertex has no texture coordinates or no normal.
+     */
+    static constexpr std::uint32_t NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * The vertex positions ('v').
+     */
+    std::vector<Vector3> positions;
+
+    /**
+     * The texture coordinates ('vt').
+     */
+    std::vector<std::array<double, 2>> textureCoordinates;
+
+    /**
+     * The vertex normals ('vn').
+     */
+    std::vector<Vector3> normals;
+
+    /**
+     * The position indexes, 3 per triangle.
+     */
+    std::vector<std::uint32_t> positionIndexes;
+
+    /**
+     * The texture coordinate indexes, 3 per triangle (NO_INDEX if not given).
+     */
+    std::vector<std::uint32_t> textureIndexes;
+
+    /**
+     * The normal indexes, 3 per triangle (NO_INDEX if not given).
+     */
+    std::vector<std::uint32_t> normalIndexes;
+
+    /**
+     * @brief Get the number of triangles.
+     *
+     * @return Returns the number of triangles.
+     */
+    std::size_t getTriangleCount() const
+    {
+        return positionIndexes.size() / 3;
+    }
+};
+
+/**
+ * @class ObjParser
+ * @brief Wavefront OBJ reader.
+ *
+ * Hand-written parser working directly on the characters of the file (numbers are read with std::from_chars), so no
+ * string is created per line or per token. Supports the 'v', 'vt', 'vn' and 'f' elements, with every face vertex
+ * form ('v', 'v/vt', 'v//vn', 'v/vt/vn'), negative indexes, and polygons (fan-triangulated). The other elements
+ * (groups, materials, ...) are ignored.
+ *
+ * The files are memory-mapped. A big file is split in chunks (on line boundaries) parsed in parallel: a first pass
+ * counts the vertex elements of each chunk, so that every chunk knows where to write its vertices and how to resolve
+ * its indexes, then the chunks are parsed and their triangles stitched together.
+ *
+ * @see ObjMesh, Model
+ */
+class ObjParser
+{
+public:
+    /**
+     * The minimum size of a chunk parsed by a thread (smaller files are parsed by one thread).
+     */
+    static constexpr std::size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+    /**
+     * @brief Read an OBJ file.
+     *
+     * @param path        The path of the file.
+     * @param threadCount The number of threads (0 for all the hardware threads).
+     *
+     * @return Returns the mesh of the file.
+     */
+    static ObjMesh read(const std::string& path, std::size_t threadCount = 0);
+
+    /**
+     * @brief Parse the content of an OBJ file.
+     *
+     * @param text        The content of the file.
+     * @param threadCount The number of threads (0 for all the hardware threads).
+     *
+     * @return Returns the mesh.
+     */
+    static ObjMesh parse(std::string_view text, std::size_t threadCount = 0);
+};
+
+#endif //H_RAYTRACING_OBJPARSER_H
@@ -1,32 +1,151 @@
+#include "Config.h"
+#include "Loaders/ImageWriter.h"
+#include "Objects/Model.h"
 #include "Scene/Scene.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
 #include <iostream>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace
+{
+    void printUsage(const char* program)
+    {
+        std::cout << "Usage: " << program
+                  << " <scene file> [thread count] [--output <image>] [--headless] [--bvh-statistics]\n"
+                  << "  thread count         Number of render threads, 1 to 1024 (default all the hardware threads)\n"
+                  << "  --output <image>     Path of the image, PPM or PNG, or BMP, TGA or JPG with the\n"
+                  << "                       viewer (default out.png)\n"
+                  << "  --headless           Only save the image, without window\n"
+                  << "  --bvh-statistics     Print the statistics of the BVH of each mesh" << std::endl;
+    }
+
+    /**
+     * The biggest thread count accepted on the command line (each thread has its buffers).
+     */
+    constexpr std::size_t MAX_THREAD_COUNT = 1024;
+
+    /**
+     * @brief Parse the thread count argument, a number from 1 to MAX_THREAD_COUNT.
+     */
+    std::optional<std::size_t> parseThreadCount(const std::string& argument)
+    {
+        // Only digits ("-3" or "2x" are rejected), and not more than the maximum so that stoul can't overflow
+        if (argument.empty() || argument.size() > std::to_string(MAX_THREAD_COUNT).size() ||
+            !std::all_of(argument.begin(), argument.end(), [](unsigned char character) {
+                return std::isdigit(character) != 0;
+            }))
+            return std::nullopt;
+
+        std::size_t threadCount = std::stoul(argument);
+        if (threadCount == 0 || threadCount > MAX_THREAD_COUNT)
+            return std::nullopt;
+
+        return threadCount;
+    }
+
+    void printMeshStatistics(const Scene& scene)
+    {
+        // The models using the same file share its mesh (and its hierarchy)
+        std::set<const Mesh*> printedMeshes;
+        for (const Model& model : scene.getObjects().getObjects<Model>())
+        {
+            if (printedMeshes.insert(model.getMesh().get()).second)
+                model.getBVH().printStatistics("mesh " + std::to_string(printedMeshes.size()));
+        }
+    }
+} // namespace
 
 int main(int argc, char** argv)
 {
-    if (argc != 2)
+    std::string scenePath;
+    std::string threadCount;
+    std::string imagePath = "out.png";
+    [[maybe_unused]] bool headless = false;
+    bool bvhStatistics = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument == "--headless")
+            headless = true;
+        else if (argument == "--bvh-statistics")
+            bvhStatistics = true;
+        else if (argument == "--output" && i + 1 < argc)
+            imagePath = argv[++i];
+        else if (scenePath.empty() && argument.rfind("--", 0) != 0)
+            scenePath = argument;
+        else if (!scenePath.empty() && threadCount.empty() && argument.rfind("--", 0) != 0)
+            threadCount = argument;
+        else
+        {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (scenePath.empty())
+    {
+        printUsage(argv[0]);
         return -1;
+    }
+
+    // Number of render threads (all the hardware threads by default)
+    std::optional<std::size_t> threads;
+    if (!threadCount.empty())
+    {
+        threads = parseThreadCount(threadCount);
+        if (!threads.has_value())
+        {
+            std::cout << "Invalid thread count: " << threadCount << " (1 to " << MAX_THREAD_COUNT << ")" << std::endl;
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    // Checked before loading and rendering the scene
+    if (!ImageWriter::isSupported(imagePath))
+    {
+        std::cout << "Unsupported image format: " << imagePath << std::endl;
+        printUsage(argv[0]);
+        return -1;
+    }
 
     try
     {
         Scene scene(Scene::camera(Vector3(0, 0, -15), Vector3(0, 0, 1), Size(1920, 1080), 1), 0.02);
 
+        if (threads.has_value())
+            scene.setThreadCount(threads.value());
+
         // Enable anti-aliasing
         scene.enableAntialiasing();
 
         // Load the lights and objects
-        scene.loadScene(argv[1]);
+        scene.loadScene(scenePath);
+
+        if (bvhStatistics)
+            printMeshStatistics(scene);
 
         // Generate image
-        scene.generate("out.png", 1);
+        scene.generate(imagePath, 1);
 
+#ifdef SFML_VIEWER
         // Show in window
-        scene.show();
+        if (!headless)
+            scene.show();
+#endif
     }
     catch (std::exception& exception)
     {
         std::cout << exception.what() << std::endl;
+        return -1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
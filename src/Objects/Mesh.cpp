@@ -0,0 +1,245 @@
+#include "Mesh.h"
+
+#include "Loaders/MappedFile.h"
+#include "Triangle.h"
+#include "Utils/Exceptions.h"
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief The loaded meshes by path, a mesh is freed with its last model.
+     */
+    struct Registry
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::weak_ptr<const Mesh>> meshes;
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+
+        return registry;
+    }
+} // namespace
+
+Mesh::Mesh(MeshCache::Content content)
+    : m_positions(std::move(content.positions)),
+      m_normals(std::move(content.normals)),
+      m_indexes(std::move(content.indexes)),
+      m_normalIndexes(std::move(content.normalIndexes)),
+      m_bvh(std::move(content.bvh))
+{
+}
+
+std::shared_ptr<const Mesh> Mesh::load(const std::string& path)
+{
+    Registry& registry = getRegistry();
+
+    // The lock is only kept for the lookup and the insertion, the files of different meshes are loaded in parallel
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        if (auto mesh = registry.meshes[path].lock())
+            return mesh;
+    }
+
+    std::error_code error;
+    MeshCache::Key key;
+    key.sourceSize = std::filesystem::file_size(path, error);
+    if (!error)
+        key.sourceTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+    if (error)
+        throw Exception::Loader::CantOpenFile(path);
+
+    // The file is only mapped (and hashed) if the cache doesn't match its size and time
+    std::unique_ptr<MappedFile> file;
+    auto hashSource = [&]() {
+        if (!file)
+        {
+            file = std::make_unique<MappedFile>(path);
+            key.sourceHash = MeshCache::hash(file->getContent());
+        }
+
+        return key.sourceHash;
+    };
+
+    // Not an error if the cache can't be written (like in a read-only directory), it's only slower next time
+    std::string cachePath = MeshCache::getPath(path);
+    auto content = MeshCache::read(cachePath, key, hashSource);
+    if (!content.has_value())
+    {
+        hashSource();
+        content = create(ObjParser::parse(file->getContent()));
+
+        MeshCache::write(cachePath, key, content.value());
+    }
+    else if (file)
+    {
+        // Same content with another time: the cache is written again with the new time, to not hash it every time
+        MeshCache::write(cachePath, key, content.value());
+    }
+
+    auto mesh = std::make_shared<const Mesh>(std::move(content.value()));
+
+    // Another thread may have loaded the same file meanwhile, its mesh is kept
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto& entry = registry.meshes[path];
+    if (auto loaded = entry.lock())
+        return loaded;
+
+    entry = mesh;
+
+    return mesh;
+}
+
+MeshCache::Content Mesh::create(ObjMesh mesh)
+{
+    // The normal of the first vertex is used for the whole triangle
+    std::vector<std::uint32_t> normalIndexes(mesh.getTriangleCount());
+    for (std::size_t i = 0; i < normalIndexes.size(); i++)
+        normalIndexes[i] = mesh.normalIndexes[i * 3];
+
+    std::vector<BoundingBox> boxes(mesh.getTriangleCount());
+    for (std::size_t i = 0; i < boxes.size(); i++)
+    {
+        boxes[i].extend(mesh.positions[mesh.positionIndexes[i * 3]]);
+        boxes[i].extend(mesh.positions[mesh.positionIndexes[i * 3 + 1]]);
+        boxes[i].extend(mesh.positions[mesh.positionIndexes[i * 3 + 2]]);
+    }
+
+    MeshCache::Content content;
+    content.positions = Buffer<Vector3>(std::move(mesh.positions));
+    content.normals = Buffer<Vector3>(std::move(mesh.normals));
+    content.indexes = Buffer<std::uint32_t>(std::move(mesh.positionIndexes));
+    content.normalIndexes = Buffer<std::uint32_t>(std::move(normalIndexes));
+    content.bvh.build(boxes);
+
+    return content;
+}
+
+std::optional<HitRecord> Mesh::getHit(const Ray& ray) const
+{
+    std::optional<HitRecord> closestHit;
+
+    // Closest hit, the traversal and the triangles skip everything farther than the current closest triangle
+    Ray closestRay = ray;
+
+    m_bvh.traverse(ray, ray.getTMax(), [&](std::size_t index, double& tMax) {
+        const Vector3& a = getVertex(index, 0);
+        auto hit = Triangle::intersect(closestRay, a, getVertex(index, 1) - a, getVertex(index, 2) - a);
+
+        if (!hit.has_value())
+            return false;
+
+        hit->primitive = index;
+        closestHit = hit;
+
+        tMax = hit->t;
+        closestRay.setTMax(tMax);
+
+        return false;
+    });
+
+    return closestHit;
+}
+
+RayPacket::Mask Mesh::getHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    RayPacket::Mask res = 0;
+    std::array<std::size_t, RayPacket::SIZE> primitives{};
+    RayPacket::Lanes u{};
+    RayPacket::Lanes v{};
+
+    m_bvh.traverse(packet, mask, [&](std::size_t index, RayPacket::Mask lanes) {
+        const Vector3& a = getVertex(index, 0);
+
+        RayPacket::Lanes triangleT;
+        RayPacket::Lanes triangleU;
+        RayPacket::Lanes triangleV;
+        RayPacket::Mask hits = Triangle::intersect(
+                packet, lanes, a, getVertex(index, 1) - a, getVertex(index, 2) - a, triangleT, triangleU, triangleV);
+
+        for (; hits != 0; hits &= hits - 1)
+        {
+            std::size_t lane = RayPacket::first(hits);
+
+            packet.tMax[lane] = triangleT[lane];
+            primitives[lane] = index;
+            u[lane] = triangleU[lane];
+            v[lane] = triangleV[lane];
+            res |= RayPacket::Mask(1) << lane;
+        }
+    });
+
+    // Only for the closest triangles
+    for (RayPacket::Mask lanes = res; lanes != 0; lanes &= lanes - 1)
+    {
+        std::size_t lane = RayPacket::first(lanes);
+
+        HitRecord& hit = packet.hits[lane];
+        hit = HitRecord();
+        hit.t = packet.tMax[lane];
+        hit.primitive = primitives[lane];
+        hit.u = u[lane];
+        hit.v = v[lane];
+    }
+
+    return res;
+}
+
+std::optional<std::size_t> Mesh::findTriangle(const Vector3& point) const
+{
+    for (std::size_t i = 0; i < getTriangleCount(); i++)
+    {
+        if (Triangle::isInTriangle(point, getVertex(i, 0), getVertex(i, 1), getVertex(i, 2)))
+            return i;
+    }
+
+    return std::nullopt;
+}
+
+const Vector3& Mesh::getVertex(std::size_t triangle, std::size_t vertex) const
+{
+    return m_positions[m_indexes[triangle * 3 + vertex]];
+}
+
+bool Mesh::hasNormal(std::size_t triangle) const
+{
+    return m_normalIndexes[triangle] != ObjMesh::NO_INDEX;
+}
+
+Vector3 Mesh::getTriangleNormal(std::size_t triangle) const
+{
+    if (hasNormal(triangle))
+        return m_normals[m_normalIndexes[triangle]];
+
+    const Vector3& a = getVertex(triangle, 0);
+
+    return Matrix::vectProduct(getVertex(triangle, 1) - a, getVertex(triangle, 2) - a);
+}
+
+std::size_t Mesh::getTriangleCount() const
+{
+    return m_indexes.size() / 3;
+}
+
+BoundingBox Mesh::getBoundingBox() const
+{
+    return m_bvh.getBoundingBox();
+}
+
+const BVH& Mesh::getBVH() const
+{
+    return m_bvh;
+}
@@ -0,0 +1,167 @@
+#ifndef H_RAYTRACING_MESH_H
+#define H_RAYTRACING_MESH_H
+
+#include "Accelerators/BVH.h"
+#include "Loaders/MeshCache.h"
+#include "Loaders/ObjParser.h"
+#include "Utils/Buffer.h"
+#include "Utils/HitRecord.h"
+#include "Utils/Ray.h"
+#include "Utils/RayPacket.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @class Mesh
+ * @brief Triangle mesh in its object space, with its hierarchy (bottom-level BVH).
+ *
+ * The mesh is stored indexed: the vertices are shared by the triangles, which are only 3 indexes. A mesh is shared by
+ * all the models (instances) using its file, each one placing it in the scene with its own transform: the memory
+ * depends on the number of different files, not on the number of models.
+ *
+ * @see Model, MeshCache
+ */
+class Mesh
+{
+public:
+    /**
+     * @brief Create a mesh.
+     *
+     * @param content The geometry and the hierarchy of the mesh.
+     */
+    explicit Mesh(MeshCache::Content content);
+
+    /**
+     * @brief Get the mesh of an object file.
+     *
+     * The meshes are kept by path, the models of a file share its mesh while one of them uses it. The mesh is also
+     * stored in a cache file beside the object file (see MeshCache), used instead as long as the object file doesn't
+     * change.
+     *
+     * @param path The path of the .obj file.
+     *
+     * @return Returns the shared mesh.
+     */
+    static std::shared_ptr<const Mesh> load(const std::string& path);
+
+    /**
+     * @brief Build the mesh read from a file (and its hierarchy).
+     *
+     * @param mesh The mesh read from the file.
+     *
+     * @return Returns the content of the mesh.
+     */
+    static MeshCache::Content create(ObjMesh mesh);
+
+    /**
+     * @brief Intersect a ray with the mesh (closest triangle).
+     *
+     * @param ray The ray, in the object space.
+     *
+     * @return Returns a hit record with t, u, v and the hit triangle set (not the point nor the normal) if the ray
+     * hits the mesh in its interval, nothing otherwise.
+     */
+    std::optional<HitRecord> getHit(const Ray& ray) const;
+
+    /**
+     * @brief Intersect the rays of a packet with the mesh (closest triangles).
+     *
+     * For each ray of the mask hitting the mesh, tMax is lowered to the hit and t, u, v and the hit triangle are set
+     * in the hit record of the lane (not the point nor the normal).
+     *
+     * @param packet The rays, in the object space.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the mesh.
+     */
+    RayPacket::Mask getHits(RayPacket& packet, RayPacket::Mask mask) const;
+
+    /**
+     * @brief Search the triangle containing a point.
+     *
+     * @param point The point, in the object space.
+     *
+     * @return Returns the index of the first triangle containing the point, nothing if there is none.
+     */
+    std::optional<std::size_t> findTriangle(const Vector3& point) const;
+
+    /**
+     * @brief Get a vertex of a triangle.
+     *
+     * @param triangle The index of the triangle.
+     * @param vertex   The vertex of the triangle (0, 1 or 2).
+     *
+     * @return Returns the position of the vertex.
+     */
+    const Vector3& getVertex(std::size_t triangle, std::size_t vertex) const;
+
+    /**
+     * @brief Check if a triangle has a normal given by the file.
+     *
+     * @param triangle The index of the triangle.
+     *
+     * @return Returns true if the file gives the normal of the triangle, false if it is the geometric normal.
+     */
+    bool hasNormal(std::size_t triangle) const;
+
+    /**
+     * @brief Get the normal of a triangle.
+     *
+     * @param triangle The index of the triangle.
+     *
+     * @return Returns the normal given by the file (for the first vertex), or the geometric normal.
+     */
+    Vector3 getTriangleNormal(std::size_t triangle) const;
+
+    /**
+     * @brief Get the number of triangles of the mesh.
+     *
+     * @return Returns the number of triangles.
+     */
+    std::size_t getTriangleCount() const;
+
+    /**
+     * @brief Get the bounds of the mesh.
+     *
+     * @return Returns the bounding box, in the object space.
+     */
+    BoundingBox getBoundingBox() const;
+
+    /**
+     * @brief Get the hierarchy over the triangles of the mesh.
+     *
+     * @return Returns the bottom-level BVH.
+     */
+    const BVH& getBVH() const;
+
+private:
+    /**
+     * The vertex positions.
+     */
+    Buffer<Vector3> m_positions;
+
+    /**
+     * The normals given by the file.
+     */
+    Buffer<Vector3> m_normals;
+
+    /**
+     * The indexes in m_positions of the vertices of the triangles, 3 per triangle.
+     */
+    Buffer<std::uint32_t> m_indexes;
+
+    /**
+     * The index in m_normals of the normal of each triangle (ObjMesh::NO_INDEX for the geometric normal).
+     */
+    Buffer<std::uint32_t> m_normalIndexes;
+
+    /**
+     * The hierarchy over the triangles (bottom-level BVH).
+     */
+    BVH m_bvh;
+};
+
+#endif //H_RAYTRACING_MESH_H
@@ -1,8 +1,24 @@
 #include "Model.h"
 
-#include "Utils/Math.h"
+#include <utility>
 
-#include <limits>
+namespace
+{
+    /**
+     * @brief Get the normal of a triangle of a mesh, in the scene.
+     */
+    Vector3 getNormal(const Mesh& mesh, const Transform& transform, std::size_t triangle)
+    {
+        // The normals of the file stay unit vectors, the geometric normal is the one of the transformed triangle
+        if (mesh.hasNormal(triangle))
+            return Matrix::normalize(transform.transformNormal(mesh.getTriangleNormal(triangle)));
+
+        const Vector3& a = mesh.getVertex(triangle, 0);
+
+        return Matrix::vectProduct(transform.transformVector(mesh.getVertex(triangle, 1) - a),
+                                   transform.transformVector(mesh.getVertex(triangle, 2) - a));
+    }
+} // namespace
 
 Model::Model(Material material,
              const Color& color,
@@ -10,139 +26,58 @@ Model::Model(Material material,
              const Vector3& coordinates,
              const Vector3& angle,
              double scale)
-    : Object(material, color),
-      m_origin(coordinates),
-      m_angle(angle),
-      m_scale(scale)
+    : Model(material, color, Mesh::load(path), Transform::placement(coordinates, angle, scale))
 {
-    readFile(path);
 }
 
-void Model::readFile(const std::string& path)
+Model::Model(Material material, const Color& color, std::shared_ptr<const Mesh> mesh, const Transform& transform)
+    : Object(material, color),
+      m_mesh(std::move(mesh)),
+      m_transform(transform),
+      m_boundingBox(m_transform.transformBox(m_mesh->getBoundingBox()))
 {
-    std::vector<Vector3> coordinatesList;
-    std::vector<Vector3> normalList;
-
-    Vector3 coordinates;
-    Vector3 a;
-    Vector3 b;
-    Vector3 c;
-
-    std::stringstream stream;
-    std::string line;
-    std::string word;
-    std::string index;
-
-    std::ifstream file(path);
-
-    if (!file.is_open())
-        throw std::runtime_error("Error when opening the file.");
-
-    while (getline(file, line))
-    {
-        stream = std::stringstream(line);
-        getline(stream, word, ' ');
-
-        if (word == "v")
-        {
-            coordinates = split(line, ' ');
-
-            coordinates = coordinates * m_scale;
-            coordinates = coordinates.rotateX(m_angle.x()).rotateY(m_angle.y()).rotateZ(m_angle.z());
-
-            coordinatesList.emplace_back(coordinates + m_origin);
-        }
-        else if (word == "vn")
-        {
-            coordinates = split(line, ' ');
-            coordinates = coordinates.rotateX(m_angle.x()).rotateY(m_angle.y()).rotateZ(m_angle.z());
-
-            normalList.emplace_back(coordinates);
-        }
-        else if (word == "f")
-        {
-            getline(stream, word, ' ');
-            a = split(word, '/');
-            getline(stream, word, ' ');
-            b = split(word, '/');
-            getline(stream, word, ' ');
-            c = split(word, '/');
-
-            m_triangle.emplace_back(Materials::metal(),
-                                    Color(50, 50, 50),
-                                    coordinatesList[static_cast<int>(a.x() - 1)],
-                                    coordinatesList[static_cast<int>(b.x() - 1)],
-                                    coordinatesList[static_cast<int>(c.x() - 1)],
-                                    normalList[static_cast<int>(a.z() - 1)]);
-        }
-    }
-    file.close();
 }
 
-Vector3 Model::split(const std::string& line, char delimiter)
+std::optional<HitRecord> Model::getHit(const Ray& ray) const
 {
-    std::string tmp = std::regex_replace(line, std::regex("//"), "/");
-
-    std::stringstream stream(tmp);
-    std::string word;
-
-    double x = 0.0;
-    double y = 0.0;
-    double z = 0.0;
+    // The ray parameter is the same in the object space, so is the interval of the ray
+    auto hit = m_mesh->getHit(m_transform.inverseTransformRay(ray));
 
-    if (delimiter == ' ')
-        getline(stream, word, delimiter);
-
-    getline(stream, word, delimiter);
-    x = std::stod(word);
-
-    if (line == tmp)
+    // Only for the closest triangle
+    if (hit.has_value())
     {
-        getline(stream, word, delimiter);
-        y = std::stod(word);
+        hit->point = ray.getDirection() * hit->t + ray.getOrigin();
+        hit->normal = ::getNormal(*m_mesh, m_transform, hit->primitive);
     }
-    else
-        y = 0;
-
-    getline(stream, word, delimiter);
-    z = std::stod(word);
 
-    return {{x, y, z}};
+    return hit;
 }
 
-std::optional<Vector3> Model::getIntersection(const Ray& ray) const
+RayPacket::Mask Model::getPacketHits(RayPacket& packet, RayPacket::Mask mask) const
 {
-    std::vector<Vector3> intersectionList;
-    std::optional<Vector3> intersection;
-
-    const Vector3& origin = ray.getOrigin();
-
-    double distance = 0.0;
-    double max = std::numeric_limits<double>::max();
-
-    for (const auto& triangle : m_triangle)
+    RayPacket local;
+    for (RayPacket::Mask lanes = mask; lanes != 0; lanes &= lanes - 1)
     {
-        intersection = triangle.getIntersection(ray);
-
-        if (intersection != std::nullopt)
-            intersectionList.emplace_back(intersection.value());
+        std::size_t lane = RayPacket::first(lanes);
+        local.setRay(lane, m_transform.inverseTransformRay(packet.getRay(lane)));
     }
 
-    if (intersectionList.empty())
-        return std::nullopt;
+    RayPacket::Mask res = m_mesh->getHits(local, mask);
 
-    for (const auto& intersectionPoint : intersectionList)
+    // Only for the closest triangles
+    for (RayPacket::Mask lanes = res; lanes != 0; lanes &= lanes - 1)
     {
-        distance = intersectionPoint.distance(origin);
-
-        if (distance < max || areDoubleApproximatelyEqual(distance, max, 0.00000001))
-        {
-            intersection = intersectionPoint;
-            max = distance;
-        }
+        std::size_t lane = RayPacket::first(lanes);
+
+        HitRecord& hit = packet.hits[lane];
+        hit = local.hits[lane];
+        hit.point = Vector3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]) * hit.t +
+                    Vector3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        hit.normal = ::getNormal(*m_mesh, m_transform, hit.primitive);
+        packet.tMax[lane] = hit.t;
     }
 
-    return intersection;
+    return res;
 }
 
 std::optional<Ray> Model::getSecondaryRay(const Vector3& intersectionPoint, const Vector3& originLight) const
@@ -152,13 +87,34 @@ std::optional<Ray> Model::getSecondaryRay(const Vector3& intersectionPoint, cons
 
 Vector3 Model::getNormal(const Vector3& intersectionPoint) const
 {
-    for (const auto& triangle : m_triangle)
-    {
-        if (triangle.isInTriangle(intersectionPoint))
-        {
-            return triangle.getNormal(intersectionPoint);
-        }
-    }
+    auto triangle = m_mesh->findTriangle(m_transform.inverseTransformPoint(intersectionPoint));
+    if (!triangle.has_value())
+        throw Exception::Object::NoIntersectionFound("Can't return a normal for model.");
+
+    return ::getNormal(*m_mesh, m_transform, triangle.value());
+}
+
+BoundingBox Model::getBoundingBox() const
+{
+    return m_boundingBox;
+}
 
-    throw Exception::Object::NoIntersectionFound("Can't return a normal for model.");
+const BVH& Model::getBVH() const
+{
+    return m_mesh->getBVH();
+}
+
+std::size_t Model::getTriangleCount() const
+{
+    return m_mesh->getTriangleCount();
+}
+
+const std::shared_ptr<const Mesh>& Model::getMesh() const
+{
+    return m_mesh;
+}
+
+const Transform& Model::getTransform() const
+{
+    return m_transform;
 }
@@ -1,24 +1,26 @@
 #ifndef H_RAYTRACING_MODEL_H
 #define H_RAYTRACING_MODEL_H
 
+#include "Accelerators/BVH.h"
+#include "Mesh.h"
 #include "Object.h"
-#include "Triangle.h"
+#include "Utils/Transform.h"
 
-#include <fstream>
-#include <regex>
-#include <sstream>
+#include <memory>
 #include <string>
-#include <vector>
 
 /**
  * @class Model
  * @brief Class that manage the model object.
  *
- * Class that manage the model object.
+ * Class that manage the model object. A model is an instance of a mesh: the mesh stays in its object space and is
+ * shared by all the models using the same file, the model only holds its transform, its material and its color. The
+ * rays are transformed into the object space of the mesh to be intersected with its hierarchy, and the scene BVH
+ * over the models (with their transformed bounding boxes) is the top level.
  *
- * @see Matrix, Color, Object, Triangle
+ * @see Mesh, Transform, Object
  */
-class Model : public Object
+class Model final : public Object
 {
 public:
     /**
@@ -28,6 +30,8 @@ public:
      * @param color       Object's color.
      * @param path        The path of the object's file.
      * @param coordinates The coordinates of the object.
+     * @param angle       The rotation of the object (in radians) around each axis.
+     * @param scale       The scale of the object.
      */
     Model(Material material,
           const Color& color,
@@ -37,13 +41,24 @@ public:
           double scale);
 
     /**
-     * @brief Method to get the intersection point with a ray and the plane.
+     * @brief Create an instance of a mesh.
+     *
+     * @param material  The object's material.
+     * @param color     Object's color.
+     * @param mesh      The mesh, in its object space.
+     * @param transform The transform from the object space of the mesh to the scene.
+     */
+    Model(Material material, const Color& color, std::shared_ptr<const Mesh> mesh, const Transform& transform);
+
+    /**
+     * @brief Method to get the intersection with a ray and the model (closest triangle).
      *
      * @param ray The ray
      *
-     * @return The intersection point if there is an intersection, nothing otherwise.
+     * @return The hit record (with the index of the hit triangle) if there is an intersection in the ray interval,
+     * nothing otherwise.
      */
-    std::optional<Vector3> getIntersection(const Ray& ray) const override;
+    std::optional<HitRecord> getHit(const Ray& ray) const override;
 
     /**
      * @brief Get the secondary ray from an intersection and origin point if there is an intersection.
@@ -58,6 +73,8 @@ public:
     /**
      * @brief Method to calculate the normal vector.
      *
+     * @warning Searches the triangle containing the point, prefer the normal of the hit record.
+     *
      * @param intersectionPoint The intersection between the primary ray and the object.
      *
      * @return Returns the normal vector.
@@ -65,33 +82,66 @@ public:
     Vector3 getNormal([[maybe_unused]] const Vector3& intersectionPoint) const override;
 
     /**
-     * Method to split a string with a delimiter
+     * @brief Get the axis-aligned bounding box of the model.
      *
-     * @param line      The line
-     * @param delimiter The delimiter
+     * @return Returns the bounding box of the model.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Get the hierarchy over the triangles of the model.
      *
-     * @return Returns the vector corresponding to the line of the obj file.
+     * @return Returns the bottom-level BVH (in the object space of the mesh).
      */
-    static Vector3 split(const std::string& line, char delimiter);
+    const BVH& getBVH() const;
+
+    /**
+     * @brief Get the number of triangles of the model.
+     *
+     * @return Returns the number of triangles.
+     */
+    std::size_t getTriangleCount() const;
 
-private:
     /**
-     * Method that read the object file.
+     * @brief Get the mesh of the model.
      *
-     * @param path   The path of the .obj file.
+     * @return Returns the shared mesh.
      */
-    void readFile(const std::string& path);
+    const std::shared_ptr<const Mesh>& getMesh() const;
 
     /**
-     * The triangle of the objects
+     * @brief Get the transform of the model.
+     *
+     * @return Returns the transform from the object space of the mesh to the scene.
      */
-    std::vector<Triangle> m_triangle;
+    const Transform& getTransform() const;
 
-    const Vector3& m_origin;
+protected:
+    /**
+     * @brief Intersect several rays of a packet with the model (packet traversal of the BVH and SIMD triangle kernel).
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the model.
+     */
+    RayPacket::Mask getPacketHits(RayPacket& packet, RayPacket::Mask mask) const override;
 
-    const Vector3& m_angle;
+private:
+    /**
+     * The shared mesh, in its object space.
+     */
+    std::shared_ptr<const Mesh> m_mesh;
+
+    /**
+     * The transform from the object space of the mesh to the scene.
+     */
+    Transform m_transform;
 
-    double m_scale;
+    /**
+     * The bounding box of the transformed mesh.
+     */
+    BoundingBox m_boundingBox;
 };
 
 #endif //H_RAYTRACING_MODEL_H
@@ -6,6 +6,50 @@ Object::Object(Material material, const Color& color) : m_color(color), m_materi
 {
 }
 
+std::optional<Vector3> Object::getIntersection(const Ray& ray) const
+{
+    auto hit = getHit(ray);
+
+    if (!hit.has_value())
+        return std::nullopt;
+
+    return hit->point;
+}
+
+RayPacket::Mask Object::getHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    if (RayPacket::count(mask) > 1)
+        return getPacketHits(packet, mask);
+
+    return Object::getPacketHits(packet, mask);
+}
+
+RayPacket::Mask Object::getPacketHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    RayPacket::Mask res = 0;
+
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+    {
+        if ((mask >> lane & 1) == 0)
+            continue;
+
+        auto hit = getHit(packet.getRay(lane));
+        if (!hit.has_value())
+            continue;
+
+        packet.tMax[lane] = hit->t;
+        packet.hits[lane] = hit.value();
+        res |= RayPacket::Mask(1) << lane;
+    }
+
+    return res;
+}
+
+bool Object::isBounded() const
+{
+    return true;
+}
+
 void Object::setColor(const Color& color)
 {
     m_color = color;
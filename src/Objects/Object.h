@@ -2,8 +2,11 @@
 #define H_RAYTRACING_OBJECT_H
 
 #include "Materials/Material.h"
+#include "Utils/BoundingBox.h"
 #include "Utils/Color.h"
+#include "Utils/HitRecord.h"
 #include "Utils/Ray.h"
+#include "Utils/RayPacket.h"
 #include "Utils/Vector3.h"
 
 #include <optional>
@@ -31,14 +34,39 @@ public:
     explicit Object(Material material, const Color& color);
     virtual ~Object() = default;
 
+    /**
+     * @brief Check if the ray intersect with the object in the ray interval [tMin, tMax].
+     *
+     * @param ray The ray to check the collision with.
+     *
+     * @return Returns the hit record (parameter, point, normal, primitive) if there is an intersection, nothing
+     * otherwise.
+     */
+    virtual std::optional<HitRecord> getHit(const Ray& ray) const = 0;
+
     /**
      * @brief Check if the ray intersect with the object, if this is the case it will return the intersection point.
      *
      * @param ray The ray to check the collision with.
      *
      * @return Returns the intersection point if there is an intersection, nothing otherwise.
+     *
+     * @see getHit
      */
-    virtual std::optional<Vector3> getIntersection(const Ray& ray) const = 0;
+    std::optional<Vector3> getIntersection(const Ray& ray) const;
+
+    /**
+     * @brief Intersect the rays of a packet with the object.
+     *
+     * For each ray of the mask hitting the object in its interval, tMax is lowered to the hit and the hit record of
+     * the lane is replaced. A ray alone is intersected with getHit(), several rays with getPacketHits().
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the object (closer than their previous hit).
+     */
+    RayPacket::Mask getHits(RayPacket& packet, RayPacket::Mask mask) const;
 
     /**
      * @brief Get the secondary ray from an intersection and origin point if there is an intersection.
@@ -59,6 +87,22 @@ public:
      */
     virtual Vector3 getNormal(const Vector3& intersectionPoint) const = 0;
 
+    /**
+     * @brief Get the axis-aligned bounding box of the object.
+     *
+     * @return Returns the bounding box of the object (infinite for unbounded objects like planes).
+     */
+    virtual BoundingBox getBoundingBox() const = 0;
+
+    /**
+     * @brief Know if the object is bounded, i.e. if it can be put in a bounding volume hierarchy.
+     *
+     * Not deduced from the bounding box: the release build assumes finite math, so infinite boxes can't be detected.
+     *
+     * @return Returns true if the object is bounded, false otherwise (like planes).
+     */
+    virtual bool isBounded() const;
+
     /**
      * @brief Method.
      *
@@ -86,6 +130,19 @@ public:
      */
     Material getMaterial() const;
 
+protected:
+    /**
+     * @brief Intersect several rays of a packet with the object (see getHits()).
+     *
+     * The default implementation intersects the rays one by one, the objects with a SIMD kernel override it.
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the object.
+     */
+    virtual RayPacket::Mask getPacketHits(RayPacket& packet, RayPacket::Mask mask) const;
+
 private:
     /**
      * The object's color.
@@ -1,7 +1,46 @@
 #include "Plane.h"
 
+#include "Utils/Simd.h"
+
+#include <array>
+#include <cstdint>
 #include <utility>
 
+namespace
+{
+    /**
+     * @brief Same computation as Plane::getHit() for every lane of a packet, the ray parameter of each lane is
+     * written in t and whether it is a hit (1 or 0) in hits.
+     */
+    SIMD_CLONES void intersectLanes(const Vector3& coordinates,
+                                    double d,
+                                    const RayPacket& packet,
+                                    RayPacket::Lanes& t,
+                                    std::array<std::int64_t, RayPacket::SIZE>& hits)
+    {
+        const double a = coordinates.x();
+        const double b = coordinates.y();
+        const double c = coordinates.z();
+
+        for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        {
+            double num = packet.originX[i] * a + packet.originY[i] * b + packet.originZ[i] * c;
+            double den = packet.directionX[i] * a + packet.directionY[i] * b + packet.directionZ[i] * c;
+
+            double hit = (d - num) / (den == 0 ? 1.0 : den);
+
+            // The intersection must be in front of the origin on each axis
+            double x = (packet.directionX[i] * hit + packet.originX[i] - packet.originX[i]) / packet.directionX[i];
+            double y = (packet.directionY[i] * hit + packet.originY[i] - packet.originY[i]) / packet.directionY[i];
+            double z = (packet.directionZ[i] * hit + packet.originZ[i] - packet.originZ[i]) / packet.directionZ[i];
+
+            t[i] = hit;
+            hits[i] = (den != 0) & ((packet.directionX[i] == 0) | (x >= 0)) & ((packet.directionY[i] == 0) | (y >= 0)) &
+                      ((packet.directionZ[i] == 0) | (z >= 0)) & (hit >= packet.tMin[i]) & (hit <= packet.tMax[i]);
+        }
+    }
+} // namespace
+
 Plane::Plane(Material material, const Color& color, Vector3 coordinates, double d)
     : Object(material, color),
       m_coordinates(std::move(coordinates)),
@@ -16,7 +55,7 @@ Plane::Plane(Material material, const Color& color, const Vector3& origin, Vecto
 {
 }
 
-std::optional<Vector3> Plane::getIntersection(const Ray& ray) const
+std::optional<HitRecord> Plane::getHit(const Ray& ray) const
 {
     const Vector3& origin = ray.getOrigin();
     const Vector3& direction = ray.getDirection();
@@ -38,7 +77,41 @@ std::optional<Vector3> Plane::getIntersection(const Ray& ray) const
         (direction.z() != 0 && (intersection.z() - origin.z()) / direction.z() < 0))
         return std::nullopt;
 
-    return intersection;
+    if (!ray.isInInterval(t))
+        return std::nullopt;
+
+    HitRecord hit;
+    hit.t = t;
+    hit.point = intersection;
+    hit.normal = m_coordinates;
+
+    return hit;
+}
+
+RayPacket::Mask Plane::getPacketHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    RayPacket::Lanes t;
+    std::array<std::int64_t, RayPacket::SIZE> hits;
+    intersectLanes(m_coordinates, m_d, packet, t, hits);
+
+    RayPacket::Mask res = 0;
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+    {
+        if ((mask >> lane & 1) == 0 || hits[lane] == 0)
+            continue;
+
+        HitRecord& hit = packet.hits[lane];
+        hit = HitRecord();
+        hit.t = t[lane];
+        hit.point = Vector3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]) * hit.t +
+                    Vector3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        hit.normal = m_coordinates;
+
+        packet.tMax[lane] = hit.t;
+        res |= RayPacket::Mask(1) << lane;
+    }
+
+    return res;
 }
 
 std::optional<Ray> Plane::getSecondaryRay(const Vector3& intersectionPoint, const Vector3& originLight) const
@@ -50,3 +123,13 @@ Vector3 Plane::getNormal([[maybe_unused]] const Vector3& intersectionPoint) cons
 {
     return m_coordinates;
 }
+
+BoundingBox Plane::getBoundingBox() const
+{
+    return BoundingBox::infinite();
+}
+
+bool Plane::isBounded() const
+{
+    return false;
+}
@@ -11,7 +11,7 @@
  *
  * @see Object, Vector3, Matrix, Color
  */
-class Plane : public Object
+class Plane final : public Object
 {
 public:
     /**
@@ -35,13 +35,13 @@ public:
     Plane(Material material, const Color& color, const Vector3& origin, Vector3 normal);
 
     /**
-     * @brief Method to get the intersection point with a ray and the plane.
+     * @brief Method to get the intersection with a ray and the plane.
      *
      * @param ray The ray
      *
-     * @return The intersection point if there is an intersection, nothing otherwise.
+     * @return The hit record if there is an intersection in the ray interval, nothing otherwise.
      */
-    std::optional<Vector3> getIntersection(const Ray& ray) const override;
+    std::optional<HitRecord> getHit(const Ray& ray) const override;
 
     /**
      * @brief Get the secondary ray from an intersection and origin point if there is an intersection.
@@ -62,6 +62,31 @@ public:
      */
     Vector3 getNormal([[maybe_unused]] const Vector3& intersectionPoint) const override;
 
+    /**
+     * @brief Get the axis-aligned bounding box of the plane.
+     *
+     * @return Returns an infinite bounding box, a plane is unbounded.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Know if the plane is bounded.
+     *
+     * @return Returns false, a plane is unbounded.
+     */
+    bool isBounded() const override;
+
+protected:
+    /**
+     * @brief Intersect several rays of a packet with the plane (SIMD kernel).
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the plane.
+     */
+    RayPacket::Mask getPacketHits(RayPacket& packet, RayPacket::Mask mask) const override;
+
 private:
     /**
      * The coordinates of the plane.
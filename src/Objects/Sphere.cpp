@@ -1,9 +1,58 @@
 #include "Sphere.h"
 
+#include "Utils/Simd.h"
 #include "Utils/Utils.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <utility>
 
+namespace
+{
+    /**
+     * @brief Same computation as Sphere::getHit() for every lane of a packet, the ray parameter of each lane is
+     * written in t and whether it is a hit (1 or 0) in hits.
+     */
+    SIMD_CLONES void intersectLanes(const Vector3& center,
+                                    double radius,
+                                    const RayPacket& packet,
+                                    RayPacket::Lanes& t,
+                                    std::array<std::int64_t, RayPacket::SIZE>& hits)
+    {
+        const double centerX = center.x();
+        const double centerY = center.y();
+        const double centerZ = center.z();
+        const double radius2 = pow2(radius);
+
+        for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        {
+            double x = packet.originX[i] - centerX;
+            double y = packet.originY[i] - centerY;
+            double z = packet.originZ[i] - centerZ;
+
+            double a = pow2(packet.directionX[i]) + pow2(packet.directionY[i]) + pow2(packet.directionZ[i]);
+            double b = 2 * (x * packet.directionX[i] + y * packet.directionY[i] + z * packet.directionZ[i]);
+            double c = pow2(x) + pow2(y) + pow2(z) - radius2;
+
+            double discriminant = pow2(b) - 4 * a * c;
+            double root = std::sqrt(std::max(discriminant, 0.0));
+
+            double t1 = (-b - root) / (2 * a);
+            double t2 = (-b + root) / (2 * a);
+
+            // The tangent point is kept even behind the origin, like in getHit()
+            double hit = t1 > 0 ? t1 : t2;
+            hit = discriminant == 0 ? t1 : hit;
+
+            t[i] = hit;
+            hits[i] = (discriminant >= 0) & ((discriminant == 0) | (hit > 0)) & (hit >= packet.tMin[i]) &
+                      (hit <= packet.tMax[i]);
+        }
+    }
+} // namespace
+
 Sphere::Sphere(Material material, const Color& color, Vector3 coordinates, double radius)
     : Object(material, color),
       m_coordinates(std::move(coordinates)),
@@ -11,7 +60,7 @@ Sphere::Sphere(Material material, const Color& color, Vector3 coordinates, doubl
 {
 }
 
-std::optional<Vector3> Sphere::getIntersection(const Ray& ray) const
+std::optional<HitRecord> Sphere::getHit(const Ray& ray) const
 {
     const Vector3& origin = ray.getOrigin();
     const Vector3& direction = ray.getDirection();
@@ -27,27 +76,64 @@ std::optional<Vector3> Sphere::getIntersection(const Ray& ray) const
 
     double discriminant = pow2(b) - 4 * a * c;
 
+    std::optional<double> t;
+
     if (discriminant == 0)
     {
         // One solution exist, it is a tangent point
-        double t = -b / (2 * a);
-
-        return direction * t + origin;
+        t = -b / (2 * a);
     }
-
-    if (discriminant > 0)
+    else if (discriminant > 0)
     {
         double t1 = (-b - std::sqrt(discriminant)) / (2 * a);
         double t2 = (-b + std::sqrt(discriminant)) / (2 * a);
 
         if (t1 > 0)
-            return direction * t1 + origin;
+            t = t1;
+        else if (t2 > 0)
+            t = t2;
+    }
+
+    if (!t.has_value() || !ray.isInInterval(t.value()))
+        return std::nullopt;
+
+    return getHit(ray, t.value());
+}
+
+HitRecord Sphere::getHit(const Ray& ray, double t) const
+{
+    HitRecord hit;
+    hit.t = t;
+    hit.point = ray.getDirection() * hit.t + ray.getOrigin();
+    hit.normal = hit.point - m_coordinates;
+
+    return hit;
+}
+
+RayPacket::Mask Sphere::getPacketHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    RayPacket::Lanes t;
+    std::array<std::int64_t, RayPacket::SIZE> hits;
+    intersectLanes(m_coordinates, m_radius, packet, t, hits);
 
-        if (t2 > 0)
-            return direction * t2 + origin;
+    RayPacket::Mask res = 0;
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+    {
+        if ((mask >> lane & 1) == 0 || hits[lane] == 0)
+            continue;
+
+        HitRecord& hit = packet.hits[lane];
+        hit = HitRecord();
+        hit.t = t[lane];
+        hit.point = Vector3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]) * hit.t +
+                    Vector3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        hit.normal = hit.point - m_coordinates;
+
+        packet.tMax[lane] = hit.t;
+        res |= RayPacket::Mask(1) << lane;
     }
 
-    return std::nullopt;
+    return res;
 }
 
 std::optional<Ray> Sphere::getSecondaryRay(const Vector3& intersectionPoint, const Vector3& originLight) const
@@ -59,3 +145,20 @@ Vector3 Sphere::getNormal(const Vector3& intersectionPoint) const
 {
     return intersectionPoint - m_coordinates;
 }
+
+BoundingBox Sphere::getBoundingBox() const
+{
+    Vector3 radius(m_radius, m_radius, m_radius);
+
+    return BoundingBox(m_coordinates - radius, m_coordinates + radius);
+}
+
+const Vector3& Sphere::getCoordinates() const
+{
+    return m_coordinates;
+}
+
+double Sphere::getRadius() const
+{
+    return m_radius;
+}
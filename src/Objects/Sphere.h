@@ -11,7 +11,7 @@
  *
  * @see Object, Vector3, Matrix, Color
  */
-class Sphere : public Object
+class Sphere final : public Object
 {
 public:
     /**
@@ -25,13 +25,23 @@ public:
     Sphere(Material material, const Color& color, Vector3 coordinates, double radius);
 
     /**
-     * @brief Method to get the intersection point with a ray and the sphere.
+     * @brief Method to get the intersection with a ray and the sphere.
      *
      * @param ray The ray
      *
-     * @return The intersection point if there is an intersection, nothing otherwise.
+     * @return The hit record if there is an intersection in the ray interval, nothing otherwise.
      */
-    std::optional<Vector3> getIntersection(const Ray& ray) const override;
+    std::optional<HitRecord> getHit(const Ray& ray) const override;
+
+    /**
+     * @brief Get the hit record of a ray hitting the sphere at a known parameter (like found by a SphereBatch).
+     *
+     * @param ray The ray.
+     * @param t   The ray parameter of the hit.
+     *
+     * @return Returns the hit record.
+     */
+    HitRecord getHit(const Ray& ray, double t) const;
 
     /**
      * @brief Get the secondary ray from an intersection and origin point if there is an intersection.
@@ -52,6 +62,38 @@ public:
      */
     Vector3 getNormal(const Vector3& intersectionPoint) const override;
 
+    /**
+     * @brief Get the axis-aligned bounding box of the sphere.
+     *
+     * @return Returns the bounding box of the sphere.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Get the center of the sphere.
+     *
+     * @return Returns the coordinates of the center.
+     */
+    const Vector3& getCoordinates() const;
+
+    /**
+     * @brief Get the radius of the sphere.
+     *
+     * @return Returns the radius.
+     */
+    double getRadius() const;
+
+protected:
+    /**
+     * @brief Intersect several rays of a packet with the sphere (SIMD kernel).
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the sphere.
+     */
+    RayPacket::Mask getPacketHits(RayPacket& packet, RayPacket::Mask mask) const override;
+
 private:
     /**
      * The coordinates of the sphere.
@@ -1,20 +1,88 @@
 #include "Triangle.h"
 
-#include "Plane.h"
 #include "Utils/Math.h"
+#include "Utils/Simd.h"
 
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <utility>
 
+namespace
+{
+    /**
+     * @brief Same computation as Triangle::intersect() for every lane of a packet, whether each lane is a hit (1 or
+     * 0) is written in hits.
+     */
+    SIMD_CLONES void intersectLanes(const Vector3& originA,
+                                    const Vector3& edgeAB,
+                                    const Vector3& edgeAC,
+                                    double determinantEpsilon,
+                                    double barycentricEpsilon,
+                                    const RayPacket& packet,
+                                    RayPacket::Lanes& t,
+                                    RayPacket::Lanes& u,
+                                    RayPacket::Lanes& v,
+                                    std::array<std::int64_t, RayPacket::SIZE>& hits)
+    {
+        const double aX = originA.x();
+        const double aY = originA.y();
+        const double aZ = originA.z();
+        const double abX = edgeAB.x();
+        const double abY = edgeAB.y();
+        const double abZ = edgeAB.z();
+        const double acX = edgeAC.x();
+        const double acY = edgeAC.y();
+        const double acZ = edgeAC.z();
+
+        for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        {
+            const double dX = packet.directionX[i];
+            const double dY = packet.directionY[i];
+            const double dZ = packet.directionZ[i];
+
+            // p = direction x AC
+            double pX = dY * acZ - dZ * acY;
+            double pY = -dX * acZ + dZ * acX;
+            double pZ = dX * acY - dY * acX;
+
+            double determinant = abX * pX + abY * pY + abZ * pZ;
+            double inverseDeterminant = 1.0 / (std::fabs(determinant) < determinantEpsilon ? 1.0 : determinant);
+
+            double sX = packet.originX[i] - aX;
+            double sY = packet.originY[i] - aY;
+            double sZ = packet.originZ[i] - aZ;
+
+            double laneU = (sX * pX + sY * pY + sZ * pZ) * inverseDeterminant;
+
+            // q = s x AB
+            double qX = sY * abZ - sZ * abY;
+            double qY = -sX * abZ + sZ * abX;
+            double qZ = sX * abY - sY * abX;
+
+            double laneV = (dX * qX + dY * qY + dZ * qZ) * inverseDeterminant;
+            double laneT = (acX * qX + acY * qY + acZ * qZ) * inverseDeterminant;
+
+            t[i] = laneT;
+            u[i] = laneU;
+            v[i] = laneV;
+            hits[i] = (std::fabs(determinant) >= determinantEpsilon) & (laneU >= -barycentricEpsilon) &
+                      (laneU <= 1.0 + barycentricEpsilon) & (laneV >= -barycentricEpsilon) &
+                      (laneU + laneV <= 1.0 + barycentricEpsilon) & (laneT >= packet.tMin[i]) &
+                      (laneT <= packet.tMax[i]);
+        }
+    }
+} // namespace
+
 Triangle::Triangle(Material material, const Color& color, Vector3 originA, Vector3 originB, Vector3 originC)
     : Object(material, color),
       m_originA(std::move(originA)),
       m_originB(std::move(originB)),
-      m_originC(std::move(originC))
+      m_originC(std::move(originC)),
+      m_edgeAB(m_originB - m_originA),
+      m_edgeAC(m_originC - m_originA)
 {
-    Vector3 u = m_originC - m_originA;
-    Vector3 v = m_originB - m_originA;
-
-    m_normal = Matrix::vectProduct(u, v) * -1;
+    m_normal = Matrix::vectProduct(m_edgeAC, m_edgeAB) * -1;
 }
 
 Triangle::Triangle(Material material,
@@ -27,26 +95,107 @@ Triangle::Triangle(Material material,
       m_originA(std::move(originA)),
       m_originB(std::move(originB)),
       m_originC(std::move(originC)),
+      m_edgeAB(m_originB - m_originA),
+      m_edgeAC(m_originC - m_originA),
       m_normal(std::move(normal))
 {
 }
 
-std::optional<Vector3> Triangle::getIntersection(const Ray& ray) const
+std::optional<HitRecord> Triangle::getHit(const Ray& ray) const
 {
-    // We find the plane equation
-    double d = m_normal.x() * m_originA.x() + m_normal.y() * m_originA.y() + m_normal.z() * m_originA.z();
+    auto hit = intersect(ray, m_originA, m_edgeAB, m_edgeAC);
+
+    if (!hit.has_value())
+        return std::nullopt;
+
+    hit->point = ray.getDirection() * hit->t + ray.getOrigin();
+    hit->normal = m_normal;
+
+    return hit;
+}
+
+std::optional<HitRecord>
+Triangle::intersect(const Ray& ray, const Vector3& originA, const Vector3& edgeAB, const Vector3& edgeAC)
+{
+    const Vector3& direction = ray.getDirection();
+
+    Vector3 p = Matrix::vectProduct(direction, edgeAC);
+    double determinant = Matrix::dot(edgeAB, p);
+
+    // The ray is parallel to the triangle
+    if (std::fabs(determinant) < DETERMINANT_EPSILON)
+        return std::nullopt;
+
+    double inverseDeterminant = 1.0 / determinant;
+
+    Vector3 s = ray.getOrigin() - originA;
+    double u = Matrix::dot(s, p) * inverseDeterminant;
+
+    if (u < -BARYCENTRIC_EPSILON || u > 1.0 + BARYCENTRIC_EPSILON)
+        return std::nullopt;
+
+    Vector3 q = Matrix::vectProduct(s, edgeAB);
+    double v = Matrix::dot(direction, q) * inverseDeterminant;
 
-    Plane plane(getMaterial(), getColor(), {m_normal.x(), m_normal.y(), m_normal.z()}, d);
+    if (v < -BARYCENTRIC_EPSILON || u + v > 1.0 + BARYCENTRIC_EPSILON)
+        return std::nullopt;
 
-    std::optional<Vector3> intersection = plane.getIntersection(ray);
+    double t = Matrix::dot(edgeAC, q) * inverseDeterminant;
 
-    if (intersection == std::nullopt)
+    if (!ray.isInInterval(t))
         return std::nullopt;
 
-    if (isInTriangle(intersection.value()))
-        return intersection;
+    HitRecord hit;
+    hit.t = t;
+    hit.u = u;
+    hit.v = v;
 
-    return std::nullopt;
+    return hit;
+}
+
+RayPacket::Mask Triangle::intersect(const RayPacket& packet,
+                                   RayPacket::Mask mask,
+                                   const Vector3& originA,
+                                   const Vector3& edgeAB,
+                                   const Vector3& edgeAC,
+                                   RayPacket::Lanes& t,
+                                   RayPacket::Lanes& u,
+                                   RayPacket::Lanes& v)
+{
+    std::array<std::int64_t, RayPacket::SIZE> hits;
+    intersectLanes(originA, edgeAB, edgeAC, DETERMINANT_EPSILON, BARYCENTRIC_EPSILON, packet, t, u, v, hits);
+
+    RayPacket::Mask res = 0;
+    for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        res |= static_cast<RayPacket::Mask>(hits[i]) << i;
+
+    return res & mask;
+}
+
+RayPacket::Mask Triangle::getPacketHits(RayPacket& packet, RayPacket::Mask mask) const
+{
+    RayPacket::Lanes t;
+    RayPacket::Lanes u;
+    RayPacket::Lanes v;
+    RayPacket::Mask res = intersect(packet, mask, m_originA, m_edgeAB, m_edgeAC, t, u, v);
+
+    for (RayPacket::Mask lanes = res; lanes != 0; lanes &= lanes - 1)
+    {
+        std::size_t lane = RayPacket::first(lanes);
+
+        HitRecord& hit = packet.hits[lane];
+        hit = HitRecord();
+        hit.t = t[lane];
+        hit.u = u[lane];
+        hit.v = v[lane];
+        hit.point = Vector3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]) * hit.t +
+                    Vector3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        hit.normal = m_normal;
+
+        packet.tMax[lane] = hit.t;
+    }
+
+    return res;
 }
 
 std::optional<Ray> Triangle::getSecondaryRay(const Vector3& intersectionPoint, const Vector3& originLight) const
@@ -56,15 +205,17 @@ std::optional<Ray> Triangle::getSecondaryRay(const Vector3& intersectionPoint, c
 
 bool Triangle::isInTriangle(const Vector3& intersectionPoint) const
 {
-    double areaTotal = getArea(m_originA, m_originB, m_originC);
-    double areaA = getArea(m_originA, m_originB, intersectionPoint);
-    double areaB = getArea(m_originB, m_originC, intersectionPoint);
-    double areaC = getArea(m_originA, m_originC, intersectionPoint);
+    return isInTriangle(intersectionPoint, m_originA, m_originB, m_originC);
+}
 
-    // The padding is necessary to compare two doubles
-    double padding = 0.00000000001;
+bool Triangle::isInTriangle(const Vector3& intersectionPoint, const Vector3& a, const Vector3& b, const Vector3& c)
+{
+    double areaTotal = getArea(a, b, c);
+    double areaA = getArea(a, b, intersectionPoint);
+    double areaB = getArea(b, c, intersectionPoint);
+    double areaC = getArea(a, c, intersectionPoint);
 
-    return areDoubleApproximatelyEqual(areaA + areaB + areaC, areaTotal, padding);
+    return areDoubleApproximatelyEqual(areaA + areaB + areaC, areaTotal, PADDING);
 }
 
 double Triangle::getArea(const Vector3& a, const Vector3& b, const Vector3& c)
@@ -81,3 +232,13 @@ Vector3 Triangle::getNormal([[maybe_unused]] const Vector3& intersectionPoint) c
 {
     return m_normal;
 }
+
+BoundingBox Triangle::getBoundingBox() const
+{
+    BoundingBox box;
+    box.extend(m_originA);
+    box.extend(m_originB);
+    box.extend(m_originC);
+
+    return box;
+}
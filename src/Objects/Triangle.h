@@ -11,7 +11,7 @@
  *
  * @see Object, Vector3, Matrix, Color
  */
-class Triangle : public Object
+class Triangle final : public Object
 {
 public:
     /**
@@ -40,13 +40,13 @@ public:
     Triangle(Material material, const Color& color, Vector3 originA, Vector3 originB, Vector3 originC, Vector3 normal);
 
     /**
-     * @brief Method to get the intersection point with a ray and the triangle.
+     * @brief Method to get the intersection with a ray and the triangle.
      *
      * @param ray The ray
      *
-     * @return The intersection point if there is an intersection, nothing otherwise.
+     * @return The hit record if there is an intersection in the ray interval, nothing otherwise.
      */
-    std::optional<Vector3> getIntersection(const Ray& ray) const override;
+    std::optional<HitRecord> getHit(const Ray& ray) const override;
 
     /**
      * @brief Get the secondary ray from an intersection and origin point if there is an intersection.
@@ -67,8 +67,75 @@ public:
      */
     Vector3 getNormal([[maybe_unused]] const Vector3& intersectionPoint) const override;
 
+    /**
+     * @brief Get the axis-aligned bounding box of the triangle.
+     *
+     * @return Returns the bounding box of the triangle.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Ray/triangle intersection kernel (Moller-Trumbore).
+     *
+     * Solves origin + t * direction = A + u * AB + v * AC directly, without building the triangle plane.
+     *
+     * @param ray     The ray.
+     * @param originA The first point A of the triangle.
+     * @param edgeAB  The edge from A to B.
+     * @param edgeAC  The edge from A to C.
+     *
+     * @return Returns a hit record with t, u and v set (not the point nor the normal) if the ray hits the triangle in
+     * its interval, nothing otherwise.
+     */
+    static std::optional<HitRecord>
+    intersect(const Ray& ray, const Vector3& originA, const Vector3& edgeAB, const Vector3& edgeAC);
+
+    /**
+     * @brief Ray/triangle intersection kernel for the rays of a packet (Moller-Trumbore on every lane at once).
+     *
+     * The packet isn't modified, the caller keeps the hits it needs.
+     *
+     * @param packet  The rays.
+     * @param mask    The lanes to intersect.
+     * @param originA The first point A of the triangle.
+     * @param edgeAB  The edge from A to B.
+     * @param edgeAC  The edge from A to C.
+     * @param t       The ray parameter of the lanes hitting the triangle.
+     * @param u       The barycentric coordinate along AB of the lanes hitting the triangle.
+     * @param v       The barycentric coordinate along AC of the lanes hitting the triangle.
+     *
+     * @return Returns the lanes of the mask hitting the triangle in their interval.
+     */
+    static RayPacket::Mask intersect(const RayPacket& packet,
+                                     RayPacket::Mask mask,
+                                     const Vector3& originA,
+                                     const Vector3& edgeAB,
+                                     const Vector3& edgeAC,
+                                     RayPacket::Lanes& t,
+                                     RayPacket::Lanes& u,
+                                     RayPacket::Lanes& v);
+
+    /**
+     * @brief Check if a point of the triangle plane is inside the triangle.
+     *
+     * @param intersectionPoint The point to check.
+     *
+     * @return Returns true if the point is in the triangle.
+     */
     bool isInTriangle(const Vector3& intersectionPoint) const;
 
+    /**
+     * @brief Check if a point of the plane of a triangle is inside the triangle.
+     *
+     * @param intersectionPoint The point to check.
+     * @param a                 The first point of the triangle.
+     * @param b                 The second point of the triangle.
+     * @param c                 The third point of the triangle.
+     *
+     * @return Returns true if the point is in the triangle.
+     */
+    static bool isInTriangle(const Vector3& intersectionPoint, const Vector3& a, const Vector3& b, const Vector3& c);
+
     /**
      * @brief Method using Heron's formula to calculate an area.
      *
@@ -80,7 +147,33 @@ public:
      */
     static double getArea(const Vector3& a, const Vector3& b, const Vector3& c);
 
+protected:
+    /**
+     * @brief Intersect several rays of a packet with the triangle (SIMD kernel).
+     *
+     * @param packet The rays.
+     * @param mask   The lanes to intersect.
+     *
+     * @return Returns the lanes hitting the triangle.
+     */
+    RayPacket::Mask getPacketHits(RayPacket& packet, RayPacket::Mask mask) const override;
+
 private:
+    /**
+     * The padding used to compare the areas (necessary to compare two doubles).
+     */
+    static constexpr double PADDING = 0.00000000001;
+
+    /**
+     * Below this determinant, the ray is considered parallel to the triangle.
+     */
+    static constexpr double DETERMINANT_EPSILON = 1e-12;
+
+    /**
+     * Tolerance on the barycentric coordinates, so that no ray goes through the edge shared by two triangles.
+     */
+    static constexpr double BARYCENTRIC_EPSILON = 1e-9;
+
     /**
      * The vector to the first point A
      */
@@ -96,6 +189,16 @@ private:
      */
     Vector3 m_originC;
 
+    /**
+     * The edge from A to B (precomputed for the intersection kernel)
+     */
+    Vector3 m_edgeAB;
+
+    /**
+     * The edge from A to C (precomputed for the intersection kernel)
+     */
+    Vector3 m_edgeAC;
+
     /**
      * The normal vector to the triangle
      */
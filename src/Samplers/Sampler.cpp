@@ -0,0 +1,194 @@
+#include "Sampler.h"
+
+#include "Utils/Exceptions.h"
+
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief Small deterministic random generator (SplitMix64).
+     */
+    class Random
+    {
+    public:
+        explicit Random(std::uint64_t seed) : m_state(seed)
+        {
+        }
+
+        std::uint64_t nextInteger()
+        {
+            m_state += 0x9E3779B97F4A7C15ull;
+
+            return mix(m_state);
+        }
+
+        /**
+         * @brief Get a random number in [0;1[.
+         */
+        double nextDouble()
+        {
+            return static_cast<double>(nextInteger() >> 11) * 0x1.0p-53;
+        }
+
+        static std::uint64_t mix(std::uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+            return value ^ (value >> 31);
+        }
+
+    private:
+        std::uint64_t m_state;
+    };
+
+    double radicalInverse(std::uint32_t index, std::uint32_t base)
+    {
+        double inverseBase = 1.0 / base;
+        double factor = inverseBase;
+        double result = 0.0;
+
+        while (index > 0)
+        {
+            result += (index % base) * factor;
+            index /= base;
+            factor *= inverseBase;
+        }
+
+        return result;
+    }
+
+    std::uint32_t reverseBits(std::uint32_t value)
+    {
+        value = (value << 16) | (value >> 16);
+        value = ((value & 0x00FF00FFu) << 8) | ((value & 0xFF00FF00u) >> 8);
+        value = ((value & 0x0F0F0F0Fu) << 4) | ((value & 0xF0F0F0F0u) >> 4);
+        value = ((value & 0x33333333u) << 2) | ((value & 0xCCCCCCCCu) >> 2);
+        value = ((value & 0x55555555u) << 1) | ((value & 0xAAAAAAAAu) >> 1);
+
+        return value;
+    }
+
+    /**
+     * @brief Second dimension of the Sobol sequence (primitive polynomial x + 1).
+     */
+    std::uint32_t sobolSecondDimension(std::uint32_t index)
+    {
+        std::uint32_t result = 0;
+
+        for (std::uint32_t direction = 1u << 31; index != 0; index >>= 1, direction ^= direction >> 1)
+        {
+            if (index & 1u)
+                result ^= direction;
+        }
+
+        return result;
+    }
+
+    double toUnitInterval(std::uint32_t value)
+    {
+        return static_cast<double>(value) * 0x1.0p-32;
+    }
+
+    double fractionalPart(double value)
+    {
+        return value - std::floor(value);
+    }
+} // namespace
+
+Sampler::Sampler(std::size_t sampleCount, Pattern pattern, std::uint64_t seed)
+    : m_sampleCount(sampleCount),
+      m_pattern(pattern),
+      m_seed(seed)
+{
+    if (sampleCount == 0)
+        throw Exception::Sampler::NoSample();
+
+    // As many rows as possible with at least as many cells as rows, the remaining cells go in the first rows
+    auto rowCount = static_cast<std::size_t>(std::sqrt(static_cast<double>(sampleCount)));
+    while (rowCount * rowCount > sampleCount)
+        rowCount--;
+    while ((rowCount + 1) * (rowCount + 1) <= sampleCount)
+        rowCount++;
+
+    for (std::size_t row = 0; row < rowCount; row++)
+        m_rowCells.push_back(sampleCount / rowCount + (row < sampleCount % rowCount ? 1 : 0));
+}
+
+std::size_t Sampler::getSampleCount() const
+{
+    return m_sampleCount;
+}
+
+Sampler::Pattern Sampler::getPattern() const
+{
+    return m_pattern;
+}
+
+void Sampler::generate(std::uint64_t pixel, Sample* samples) const
+{
+    switch (m_pattern)
+    {
+        case Pattern::STRATIFIED:
+            generateStratified(pixel, false, samples);
+            break;
+        case Pattern::JITTERED:
+            generateStratified(pixel, true, samples);
+            break;
+        case Pattern::HALTON:
+        {
+            // Cranley-Patterson rotation, so that the pixels don't share the same pattern
+            Random random(Random::mix(m_seed) ^ pixel);
+            double shiftX = random.nextDouble();
+            double shiftY = random.nextDouble();
+
+            for (std::size_t i = 0; i < m_sampleCount; i++)
+            {
+                auto index = static_cast<std::uint32_t>(i);
+
+                samples[i].x = fractionalPart(radicalInverse(index, 2) + shiftX);
+                samples[i].y = fractionalPart(radicalInverse(index, 3) + shiftY);
+            }
+            break;
+        }
+        case Pattern::SOBOL:
+        {
+            // Random digit scrambling, which keeps the stratification of the sequence
+            Random random(Random::mix(m_seed) ^ pixel);
+            auto scrambleX = static_cast<std::uint32_t>(random.nextInteger());
+            auto scrambleY = static_cast<std::uint32_t>(random.nextInteger());
+
+            for (std::size_t i = 0; i < m_sampleCount; i++)
+            {
+                auto index = static_cast<std::uint32_t>(i);
+
+                samples[i].x = toUnitInterval(reverseBits(index) ^ scrambleX);
+                samples[i].y = toUnitInterval(sobolSecondDimension(index) ^ scrambleY);
+            }
+            break;
+        }
+    }
+}
+
+void Sampler::generateStratified(std::uint64_t pixel, bool jitter, Sample* samples) const
+{
+    Random random(Random::mix(m_seed) ^ pixel);
+
+    double rowHeight = 1.0 / static_cast<double>(m_rowCells.size());
+
+    for (std::size_t row = 0; row < m_rowCells.size(); row++)
+    {
+        double cellWidth = 1.0 / static_cast<double>(m_rowCells[row]);
+
+        for (std::size_t cell = 0; cell < m_rowCells[row]; cell++)
+        {
+            double offsetX = jitter ? random.nextDouble() : 0.5;
+            double offsetY = jitter ? random.nextDouble() : 0.5;
+
+            samples->x = (static_cast<double>(cell) + offsetX) * cellWidth;
+            samples->y = (static_cast<double>(row) + offsetY) * rowHeight;
+            samples++;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef H_RAYTRACING_SAMPLER_H
+#define H_RAYTRACING_SAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct Sample
+ * @brief Position of a sample in a pixel, each coordinate in [0;1[ (0.5, 0.5 is the center of the pixel).
+ */
+struct Sample
+{
+    double x = 0.5;
+    double y = 0.5;
+};
+
+/**
+ * @class Sampler
+ * @brief Generate the positions of the samples of the pixels, used for anti-aliasing.
+ *
+ * A sampler always gives exactly getSampleCount() samples per pixel, so the cost of a render is proportional to it.
+ * The patterns:
+ *  - STRATIFIED: the pixel is split in getSampleCount() cells of the same area, and sampled at their centers.
+ *  - JITTERED: same cells, sampled at a random position in each cell.
+ *  - HALTON: the first points of the Halton sequence (bases 2 and 3), randomly shifted per pixel.
+ *  - SOBOL: the first points of the 2D Sobol sequence, randomly scrambled per pixel.
+ *
+ * The random values only depend on the seed and on the pixel, so an image doesn't depend on the number of threads.
+ */
+class Sampler
+{
+public:
+    /**
+     * @brief The sample patterns.
+     */
+    enum class Pattern
+    {
+        STRATIFIED,
+        JITTERED,
+        HALTON,
+        SOBOL
+    };
+
+    /**
+     * @brief Create a sampler.
+     *
+     * @param sampleCount The number of samples per pixel (at least 1).
+     * @param pattern     The sample pattern.
+     * @param seed        The seed of the random values.
+     */
+    Sampler(std::size_t sampleCount, Pattern pattern, std::uint64_t seed = 0);
+
+    std::size_t getSampleCount() const;
+    Pattern getPattern() const;
+
+    /**
+     * @brief Generate the samples of a pixel.
+     *
+     * @param pixel   The index of the pixel in the image (y * width + x).
+     * @param samples The first of the getSampleCount() samples to write.
+     */
+    void generate(std::uint64_t pixel, Sample* samples) const;
+
+private:
+    /**
+     * @brief Generate the samples in the cells of the pixel.
+     *
+     * @param pixel   The index of the pixel in the image.
+     * @param jitter  True to take a random position in the cells, false for their centers.
+     * @param samples The first sample to write.
+     */
+    void generateStratified(std::uint64_t pixel, bool jitter, Sample* samples) const;
+
+    std::size_t m_sampleCount;
+    Pattern m_pattern;
+    std::uint64_t m_seed;
+
+    /**
+     * The number of cells in each row of cells (the rows have the same height, and the cells of a row the same width).
+     */
+    std::vector<std::size_t> m_rowCells;
+};
+
+#endif //H_RAYTRACING_SAMPLER_H
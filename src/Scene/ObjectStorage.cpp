@@ -0,0 +1,19 @@
+#include "ObjectStorage.h"
+
+const Object& ObjectStorage::get(ObjectId id) const
+{
+    return visit(id, [](const Object& object) -> const Object& { return object; });
+}
+
+std::size_t ObjectStorage::size() const
+{
+    return m_spheres.size() + m_planes.size() + m_triangles.size() + m_models.size();
+}
+
+void ObjectStorage::clear()
+{
+    m_spheres.clear();
+    m_planes.clear();
+    m_triangles.clear();
+    m_models.clear();
+}
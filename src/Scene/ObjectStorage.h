@@ -0,0 +1,208 @@
+#ifndef H_RAYTRACING_OBJECTSTORAGE_H
+#define H_RAYTRACING_OBJECTSTORAGE_H
+
+#include "Objects/Model.h"
+#include "Objects/Object.h"
+#include "Objects/Plane.h"
+#include "Objects/Sphere.h"
+#include "Objects/Triangle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct ObjectId
+ * @brief Reference to an object of an ObjectStorage: its type and its index in the array of this type.
+ */
+struct ObjectId
+{
+    /**
+     * @enum Type
+     * @brief The types of objects of a scene.
+     */
+    enum class Type : std::uint32_t
+    {
+        SPHERE,
+        PLANE,
+        TRIANGLE,
+        MODEL
+    };
+
+    Type type = Type::SPHERE; /*!< The type of the object. */
+    std::uint32_t index = 0;  /*!< The index of the object in the array of its type. */
+
+    bool operator==(const ObjectId& id) const
+    {
+        return type == id.type && index == id.index;
+    }
+
+    bool operator!=(const ObjectId& id) const
+    {
+        return !(*this == id);
+    }
+};
+
+/**
+ * @class ObjectStorage
+ * @brief The objects of a scene, stored by value in one contiguous array per type.
+ *
+ * The set of types is closed (the final classes Sphere, Plane, Triangle and Model): an object is referenced by an
+ * ObjectId, and visit() calls a function with the object as its real type, so the intersection methods are called
+ * directly (no virtual call, no shared pointer to copy).
+ *
+ * @warning Adding an object may move the objects of its type, only keep the ids.
+ *
+ * @see Scene, ObjectId
+ */
+class ObjectStorage
+{
+public:
+    /**
+     * @brief Add an object.
+     *
+     * @tparam T The type to create (Sphere, Plane, Triangle or Model).
+     *
+     * @param args Args to use to create the object T.
+     *
+     * @return Returns the id of the object.
+     */
+    template<typename T, typename... Args>
+    ObjectId add(Args&&... args)
+    {
+        auto& objects = getArray<T>(*this);
+        objects.emplace_back(std::forward<Args>(args)...);
+
+        return {getType<T>(), static_cast<std::uint32_t>(objects.size() - 1)};
+    }
+
+    /**
+     * @brief Call a function with an object as its real type.
+     *
+     * @param id       The id of the object.
+     * @param function The function, called with a const reference to the Sphere, Plane, Triangle or Model.
+     *
+     * @return Returns the result of the function.
+     */
+    template<typename Function>
+    decltype(auto) visit(ObjectId id, Function&& function) const
+    {
+        switch (id.type)
+        {
+            case ObjectId::Type::SPHERE:
+                return function(m_spheres[id.index]);
+            case ObjectId::Type::PLANE:
+                return function(m_planes[id.index]);
+            case ObjectId::Type::TRIANGLE:
+                return function(m_triangles[id.index]);
+            default:
+                return function(m_models[id.index]);
+        }
+    }
+
+    /**
+     * @brief Call a function with each object (as its real type) and its id.
+     *
+     * @param function The function, called with the id and a const reference to the object.
+     */
+    template<typename Function>
+    void forEach(Function&& function) const
+    {
+        forEachOf(ObjectId::Type::SPHERE, m_spheres, function);
+        forEachOf(ObjectId::Type::PLANE, m_planes, function);
+        forEachOf(ObjectId::Type::TRIANGLE, m_triangles, function);
+        forEachOf(ObjectId::Type::MODEL, m_models, function);
+    }
+
+    /**
+     * @brief Get an object (for the calls which aren't worth a visit(), like the material).
+     *
+     * @param id The id of the object.
+     *
+     * @return Returns the object.
+     */
+    const Object& get(ObjectId id) const;
+
+    /**
+     * @brief Get the objects of a type.
+     *
+     * @tparam T The type of the objects.
+     *
+     * @return Returns the objects of type T.
+     */
+    template<typename T>
+    const std::vector<T>& getObjects() const
+    {
+        return getArray<T>(*this);
+    }
+
+    /**
+     * @brief Get the number of objects of every type.
+     *
+     * @return Returns the number of objects.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Remove all the objects.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Get the type of the id of the objects of type T (compile error for the other types).
+     */
+    template<typename T>
+    static constexpr ObjectId::Type getType()
+    {
+        static_assert(std::is_same_v<T, Sphere> || std::is_same_v<T, Plane> || std::is_same_v<T, Triangle> ||
+                              std::is_same_v<T, Model>,
+                      "The objects of a scene are spheres, planes, triangles or models");
+
+        if constexpr (std::is_same_v<T, Sphere>)
+            return ObjectId::Type::SPHERE;
+        else if constexpr (std::is_same_v<T, Plane>)
+            return ObjectId::Type::PLANE;
+        else if constexpr (std::is_same_v<T, Triangle>)
+            return ObjectId::Type::TRIANGLE;
+        else
+            return ObjectId::Type::MODEL;
+    }
+
+    /**
+     * @brief Get the array of the objects of type T (const or not, like the storage).
+     */
+    template<typename T, typename Storage>
+    static auto& getArray(Storage& storage)
+    {
+        constexpr ObjectId::Type type = getType<T>();
+
+        if constexpr (type == ObjectId::Type::SPHERE)
+            return storage.m_spheres;
+        else if constexpr (type == ObjectId::Type::PLANE)
+            return storage.m_planes;
+        else if constexpr (type == ObjectId::Type::TRIANGLE)
+            return storage.m_triangles;
+        else
+            return storage.m_models;
+    }
+
+    /**
+     * @brief Call a function with each object of an array and its id.
+     */
+    template<typename T, typename Function>
+    static void forEachOf(ObjectId::Type type, const std::vector<T>& objects, Function& function)
+    {
+        for (std::size_t i = 0; i < objects.size(); i++)
+            function(ObjectId{type, static_cast<std::uint32_t>(i)}, objects[i]);
+    }
+
+    std::vector<Sphere> m_spheres;
+    std::vector<Plane> m_planes;
+    std::vector<Triangle> m_triangles;
+    std::vector<Model> m_models;
+};
+
+#endif //H_RAYTRACING_OBJECTSTORAGE_H
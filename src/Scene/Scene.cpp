@@ -4,25 +4,72 @@
 #include "Light/Directional.h"
 #include "Light/Punctual.h"
 #include "Light/Spot.h"
+#include "Loaders/ImageWriter.h"
 #include "Objects/Model.h"
 #include "Objects/Plane.h"
 #include "Objects/Sphere.h"
 #include "Utils/Math.h"
+#include "Utils/Parallel.h"
 #include "Utils/Utils.h"
 
+#ifdef SFML_VIEWER
 #include <SFML/Graphics.hpp>
-#include <cmath>
-
-#ifdef PARALLELIZATION
-#include <algorithm>
-#include <execution>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <map>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+namespace
+{
+    /**
+     * The rays traced by the current thread, collected by the render after each tile.
+     */
+    thread_local Scene::RenderStatistics threadRays;
+
+    void addRays(Scene::RenderStatistics& statistics, const Scene::RenderStatistics& rays)
+    {
+        statistics.primaryRayCount += rays.primaryRayCount;
+        statistics.shadowRayCount += rays.shadowRayCount;
+        statistics.reflectionRayCount += rays.reflectionRayCount;
+        statistics.refractionRayCount += rays.refractionRayCount;
+    }
+
+    /**
+     * @brief Get the contrast of a pixel: the biggest difference of a channel with the surrounding pixels.
+     *
+     * The channels are clamped like in the final image, so that the overexposed areas have no contrast.
+     */
+    double getContrast(const Framebuffer& framebuffer, std::size_t x, std::size_t y)
+    {
+        Radiance pixel = framebuffer.getPixel(x, y);
+
+        auto clamp = [](float channel) { return std::clamp(channel, 0.0f, 1.0f); };
+
+        double contrast = 0.0;
+        for (std::size_t neighbourY = y == 0 ? 0 : y - 1; neighbourY <= y + 1 && neighbourY < framebuffer.height();
+             neighbourY++)
+        {
+            for (std::size_t neighbourX = x == 0 ? 0 : x - 1; neighbourX <= x + 1 && neighbourX < framebuffer.width();
+                 neighbourX++)
+            {
+                Radiance neighbour = framebuffer.getPixel(neighbourX, neighbourY);
+
+                contrast = std::max({contrast,
+                                     static_cast<double>(std::abs(clamp(neighbour.red()) - clamp(pixel.red()))),
+                                     static_cast<double>(std::abs(clamp(neighbour.green()) - clamp(pixel.green()))),
+                                     static_cast<double>(std::abs(clamp(neighbour.blue()) - clamp(pixel.blue())))});
+            }
+        }
+
+        return contrast;
+    }
+} // namespace
+
 Scene::Scene(std::shared_ptr<Camera> camera, double ambientLight)
     : m_camera(std::move(camera)),
       m_ambientLight(ambientLight)
@@ -111,8 +158,6 @@ void Scene::loadScene(const std::string& path)
         }
         else if (word == "Model")
         {
-            std::cout << line << std::endl;
-
             material = splitMaterial(stream);
             color = splitColor(stream);
             getline(stream, pathModel, ' ');
@@ -124,6 +169,64 @@ void Scene::loadScene(const std::string& path)
             addObject<Model>(material, color, pathModel, coordinates, angle, scale);
         }
     }
+
+    buildBVH();
+}
+
+const ObjectStorage& Scene::getObjects() const
+{
+    return m_objects;
+}
+
+void Scene::buildBVH()
+{
+    m_boundedObjects.clear();
+    m_unboundedObjects.clear();
+
+    std::vector<BoundingBox> boxes;
+    m_objects.forEach([&](ObjectId id, const Object& object) {
+        if (object.isBounded())
+        {
+            m_boundedObjects.push_back(id);
+            boxes.push_back(object.getBoundingBox());
+        }
+        else
+        {
+            m_unboundedObjects.push_back(id);
+        }
+    });
+
+    m_bvh.build(boxes);
+
+    m_leafObjects.clear();
+    m_sphereBatch.clear();
+    for (std::uint32_t index : m_bvh.getIndices())
+    {
+        ObjectId object = m_boundedObjects[index];
+        m_leafObjects.push_back(object);
+
+        if (object.type == ObjectId::Type::SPHERE)
+        {
+            const Sphere& sphere = m_objects.getObjects<Sphere>()[object.index];
+            m_sphereBatch.add(sphere.getCoordinates(), sphere.getRadius());
+        }
+        else
+        {
+            m_sphereBatch.addEmpty();
+        }
+    }
+
+    m_bvhOutdated = false;
+}
+
+bool Scene::isSphereBatchLeaf(std::size_t begin, std::size_t count) const
+{
+    auto first = m_leafObjects.begin() + static_cast<std::ptrdiff_t>(begin);
+    auto sphereCount = std::count_if(first, first + static_cast<std::ptrdiff_t>(count), [](ObjectId object) {
+        return object.type == ObjectId::Type::SPHERE;
+    });
+
+    return static_cast<std::size_t>(sphereCount) >= SphereBatch::MIN_SPHERES;
 }
 
 Material Scene::splitMaterial(std::stringstream& stream)
@@ -226,12 +329,20 @@ Color Scene::getColor(const std::string& name)
 
 Scene& Scene::generate(const std::string& imagePath, unsigned int recursivity)
 {
-    compute(recursivity)->saveToFile(imagePath);
-    m_lastSavedImage = imagePath;
+    // Before the render, not after it
+    if (!ImageWriter::isSupported(imagePath))
+        throw Exception::Loader::UnsupportedFormat(imagePath);
+
+    if (m_bvhOutdated)
+        buildBVH();
+
+    m_lastImage = compute(recursivity);
+    ImageWriter::write(imagePath, *m_lastImage);
 
     return *this;
 }
 
+#ifdef SFML_VIEWER
 Scene& Scene::show()
 {
     auto width = static_cast<unsigned int>(m_camera->getResolution().width());
@@ -239,16 +350,16 @@ Scene& Scene::show()
 
     sf::RenderWindow window(sf::VideoMode(width, height), "Raytracing");
 
-    sf::Image image;
-    if (!m_lastSavedImage.empty())
+    if (!m_lastImage)
     {
-        image.loadFromFile(m_lastSavedImage);
-    }
-    else
-    {
-        image = *compute();
+        if (m_bvhOutdated)
+            buildBVH();
+
+        m_lastImage = compute();
     }
 
+    sf::Image image = m_lastImage->toImage();
+
     sf::Texture texture;
     texture.loadFromImage(image);
 
@@ -271,24 +382,51 @@ Scene& Scene::show()
 
     return *this;
 }
+#endif
+
+void Scene::setThreadCount(std::size_t threadCount)
+{
+    m_threadCount = threadCount;
+}
+
+std::size_t Scene::getThreadCount() const
+{
+#ifdef PARALLELIZATION
+    return resolveThreadCount(m_threadCount);
+#else
+    return 1;
+#endif
+}
+
+void Scene::setPacketTracing(bool packetTracing)
+{
+    m_packetTracing = packetTracing;
+}
+
+const Scene::RenderStatistics& Scene::getRenderStatistics() const
+{
+    return m_renderStatistics;
+}
 
-void Scene::enableAntialiasing(std::size_t antialiasingSampling)
+void Scene::enableAntialiasing(std::size_t samplesPerPixel, Sampler::Pattern pattern, bool adaptive)
 {
-    m_antialiasingSampling = antialiasingSampling;
+    m_sampler.emplace(samplesPerPixel, pattern);
+    m_adaptiveAntialiasing = adaptive;
 }
 
 void Scene::disableAntialiasing()
 {
-    m_antialiasingSampling = 0;
+    m_sampler.reset();
 }
 
-std::shared_ptr<sf::Image> Scene::compute(unsigned int recursivity) const
+Framebuffer Scene::compute(unsigned int recursivity) const
 {
-    auto resolution = m_camera->getResolution();
+    auto start = std::chrono::steady_clock::now();
+
+    RenderStatistics statistics;
+    statistics.threadCount = getThreadCount();
 
-    // Create the image
-    auto res = std::make_shared<sf::Image>();
-    res->create(static_cast<unsigned int>(resolution.width()), static_cast<unsigned int>(resolution.height()));
+    auto resolution = m_camera->getResolution();
 
     // Projection plan size
     const double projectionPlanSizeX = 2.0;
@@ -314,148 +452,368 @@ std::shared_ptr<sf::Image> Scene::compute(unsigned int recursivity) const
     double stepX = projectionPlanSizeX / static_cast<double>(resolution.width());
     double stepY = projectionPlanSizeY / static_cast<double>(resolution.height());
 
-    // Create the image, pixel by pixel
-#ifdef PARALLELIZATION
+    // Primary ray through a point of the projection plan
+    auto getPrimaryRay = [&](double projectionPlanPointX, double projectionPlanPointY) {
+        // Direction
+        Vector3 direction = Vector3(projectionPlanPointX, projectionPlanPointY, projectionPlanCenter.z());
 
-    // Prepare parallelization
-    std::vector<std::size_t> count(resolution.width());
-    std::iota(std::begin(count), std::end(count), 0);
+        return Ray(m_camera->getCoordinates(), (m_camera->getDirection() + direction).normalize(), PRIMARY);
+    };
 
-    std::for_each(std::execution::par, std::begin(count), std::end(count), [&](std::size_t x) {
-#else
-    for (std::size_t x = 0; x < resolution.width(); x++)
-    {
-#endif
-        for (std::size_t y = 0; y < resolution.height(); y++)
+    // Color of a primary ray
+    auto computeColor = [&](const IntersectionResult& intersection, const Ray& ray) {
+        if (!intersection.has_value())
+            return Radiance(m_backgroundColor);
+
+        const auto& [object, hit] = intersection.value();
+
+        return getColor(object, hit, ray, recursivity);
+    };
+
+    // Colors seen through points of the projection plan
+    auto tracePoints = [&](const double* pointsX, const double* pointsY, std::size_t count, Radiance* colors) {
+        threadRays.primaryRayCount += count;
+
+        if (!m_packetTracing)
         {
-            Color color = m_backgroundColor;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                Ray ray = getPrimaryRay(pointsX[i], pointsY[i]);
+                colors[i] = computeColor(getIntersectedObject(ray), ray);
+            }
+
+            return;
+        }
+
+        RayPacket packet;
+        std::array<IntersectionResult, RayPacket::SIZE> intersections;
+
+        for (std::size_t begin = 0; begin < count; begin += RayPacket::SIZE)
+        {
+            std::size_t laneCount = std::min(RayPacket::SIZE, count - begin);
+            for (std::size_t lane = 0; lane < laneCount; lane++)
+                packet.setRay(lane, getPrimaryRay(pointsX[begin + lane], pointsY[begin + lane]));
+
+            getIntersectedObjects(packet, RayPacket::firstLanes(laneCount), intersections);
 
-            if (m_antialiasingSampling != 0)
+            // The shading is done ray by ray
+            for (std::size_t lane = 0; lane < laneCount; lane++)
             {
-                int padding = static_cast<int>(std::sqrt(m_antialiasingSampling));
+                Ray ray = packet.getRay(lane);
+                ray.setTMax(std::numeric_limits<double>::infinity());
 
-                double samplingStepX = stepX / padding;
-                double samplingStepY = stepY / padding;
+                colors[begin + lane] = computeColor(intersections[lane], ray);
+            }
+        }
+    };
+
+    // With adaptive anti-aliasing, only the pixels contrasting with their neighbours in the first pass are sampled
+    auto isSupersampled = [&](std::size_t x, std::size_t y, const Framebuffer* firstPass) {
+        if (!m_sampler.has_value())
+            return false;
+
+        if (!m_adaptiveAntialiasing)
+            return true;
 
-                int centeredPadding = padding / 2;
+        return firstPass != nullptr && getContrast(*firstPass, x, y) > ADAPTIVE_ANTIALIASING_CONTRAST;
+    };
 
-                Vector3 colors;
+    // Split the image in tiles
+    std::size_t tileCountX = (resolution.width() + TILE_SIZE - 1) / TILE_SIZE;
+    std::size_t tileCountY = (resolution.height() + TILE_SIZE - 1) / TILE_SIZE;
 
-                double baseX = x * stepX + imagePlanMin.x() - stepX / (padding * 2);
-                double baseY = y * stepY + imagePlanMin.y() - stepY / (padding * 2);
+    // Render the image (the pixels not supersampled are taken from the first pass if any)
+    auto renderTiles = [&](const Framebuffer* firstPass) {
+        Framebuffer res(resolution.width(), resolution.height());
 
-                // Sampling
-                for (int i = 0; i <= centeredPadding; i++)
+        // Each thread renders its tiles in its own buffer (a block of TILE_SIZE * TILE_SIZE pixels per tile)
+        struct TileBuffer
+        {
+            std::vector<std::size_t> tiles;
+            std::vector<Radiance> pixels;
+
+            /**
+             * Whether each pixel of the current tile is supersampled (1 or 0), decided once per pixel.
+             */
+            std::vector<std::uint8_t> supersampledPixels;
+
+            /**
+             * The samples of the supersampled pixels of the current tile.
+             */
+            std::vector<Sample> samples;
+
+            /**
+             * The points of the projection plan traced for the current tile, the pixel (in pixels) each one is added
+             * to and its color.
+             */
+            std::vector<double> pointsX;
+            std::vector<double> pointsY;
+            std::vector<std::size_t> targets;
+            std::vector<Radiance> colors;
+
+            /**
+             * The supersampled pixels (in pixels) of the current tile.
+             */
+            std::vector<std::size_t> supersampled;
+
+            /**
+             * The rays traced for the tiles.
+             */
+            RenderStatistics rays;
+        };
+
+        std::vector<TileBuffer> buffers(getThreadCount());
+
+        auto computeTile = [&](std::size_t tile, std::size_t thread) {
+            auto& buffer = buffers[thread];
+            buffer.tiles.push_back(tile);
+
+            threadRays = RenderStatistics();
+
+            std::size_t minX = (tile % tileCountX) * TILE_SIZE;
+            std::size_t minY = (tile / tileCountX) * TILE_SIZE;
+            std::size_t maxX = std::min(minX + TILE_SIZE, resolution.width());
+            std::size_t maxY = std::min(minY + TILE_SIZE, resolution.height());
+
+            // Generate the samples of the whole tile before tracing
+            std::size_t sampleCount = m_sampler.has_value() ? m_sampler->getSampleCount() : 0;
+            buffer.samples.resize(TILE_SIZE * TILE_SIZE * sampleCount);
+
+            buffer.supersampledPixels.resize(TILE_SIZE * TILE_SIZE);
+
+            auto getSamples = [&](std::size_t x, std::size_t y) {
+                return buffer.samples.data() + ((y - minY) * TILE_SIZE + x - minX) * sampleCount;
+            };
+
+            // The contrast is computed once per pixel, then the samples are traced block by block
+            auto isPixelSupersampled = [&](std::size_t x, std::size_t y) {
+                return buffer.supersampledPixels[(y - minY) * TILE_SIZE + x - minX] != 0;
+            };
+
+            for (std::size_t y = minY; y < maxY; y++)
+            {
+                for (std::size_t x = minX; x < maxX; x++)
                 {
-                    for (int j = 0; j <= centeredPadding; j++)
+                    bool supersampled = isSupersampled(x, y, firstPass);
+                    buffer.supersampledPixels[(y - minY) * TILE_SIZE + x - minX] = supersampled ? 1 : 0;
+
+                    if (supersampled)
+                        m_sampler->generate(y * resolution.width() + x, getSamples(x, y));
+                }
+            }
+
+            // The block of the tile (partial tiles keep a full block)
+            std::size_t tileBegin = buffer.pixels.size();
+            buffer.pixels.resize(tileBegin + TILE_SIZE * TILE_SIZE);
+
+            buffer.pointsX.clear();
+            buffer.pointsY.clear();
+            buffer.targets.clear();
+            buffer.supersampled.clear();
+
+            auto addPoint = [&](double projectionPlanPointX, double projectionPlanPointY, std::size_t target) {
+                buffer.pointsX.push_back(projectionPlanPointX);
+                buffer.pointsY.push_back(projectionPlanPointY);
+                buffer.targets.push_back(target);
+            };
+
+            // The points are listed by blocks of neighbouring pixels, so that the packets are coherent
+            for (std::size_t blockY = minY; blockY < maxY; blockY += PACKET_BLOCK_SIZE)
+            {
+                for (std::size_t blockX = minX; blockX < maxX; blockX += PACKET_BLOCK_SIZE)
+                {
+                    for (std::size_t y = blockY; y < std::min(blockY + PACKET_BLOCK_SIZE, maxY); y++)
                     {
-                        // Coordinates
-                        double projectionPlanPointX = baseX + i * samplingStepX;
-                        double projectionPlanPointY = baseY + j * samplingStepY;
-
-                        // Direction
-                        Vector3 direction =
-                                Vector3(projectionPlanPointX, projectionPlanPointY, projectionPlanCenter.z());
-
-                        // Create the ray
-                        Ray ray(m_camera->getCoordinates(),
-                                Matrix::normalize(m_camera->getDirection() + direction).toVector3(),
-                                PRIMARY);
-
-                        // Get the intersection object and point
-                        auto intersection = getIntersectedObject(ray);
-                        if (intersection.has_value())
+                        for (std::size_t x = blockX; x < std::min(blockX + PACKET_BLOCK_SIZE, maxX); x++)
                         {
-                            auto& [object, point] = intersection.value();
-
-                            colors = colors + getColor(object, point, ray, recursivity);
+                            std::size_t target = tileBegin + (y - minY) * TILE_SIZE + x - minX;
+
+                            if (isPixelSupersampled(x, y))
+                            {
+                                // The pixel is centered on the point used without anti-aliasing
+                                const Sample* samples = getSamples(x, y);
+                                for (std::size_t i = 0; i < sampleCount; i++)
+                                {
+                                    addPoint((x + samples[i].x - 0.5) * stepX + imagePlanMin.x(),
+                                             (y + samples[i].y - 0.5) * stepY + imagePlanMin.y(),
+                                             target);
+                                }
+
+                                buffer.supersampled.push_back(target);
+                            }
+                            else if (firstPass != nullptr)
+                                buffer.pixels[target] = firstPass->getPixel(x, y);
+                            else
+                                addPoint(x * stepX + imagePlanMin.x(), y * stepY + imagePlanMin.y(), target);
                         }
-                        else
-                            colors = colors + m_backgroundColor;
                     }
                 }
-
-                color = colors * (1.0 / static_cast<double>(m_antialiasingSampling));
             }
-            else
-            {
-                // Coordinates
-                double projectionPlanPointX = x * stepX + imagePlanMin.x();
-                double projectionPlanPointY = y * stepY + imagePlanMin.y();
 
-                // Direction
-                Vector3 direction = Vector3(projectionPlanPointX, projectionPlanPointY, projectionPlanCenter.z());
+            buffer.colors.resize(buffer.targets.size());
+            tracePoints(buffer.pointsX.data(), buffer.pointsY.data(), buffer.targets.size(), buffer.colors.data());
 
-                // Create the ray
-                Ray ray(m_camera->getCoordinates(),
-                        Matrix::normalize(m_camera->getDirection() + direction).toVector3(),
-                        PRIMARY);
+            for (std::size_t i = 0; i < buffer.targets.size(); i++)
+                buffer.pixels[buffer.targets[i]] += buffer.colors[i];
 
-                // Get the intersection object and point
-                auto intersection = getIntersectedObject(ray);
-                if (intersection.has_value())
-                {
-                    auto& [object, point] = intersection.value();
+            for (std::size_t target : buffer.supersampled)
+                buffer.pixels[target] = buffer.pixels[target] * (1.0 / static_cast<double>(sampleCount));
+
+            addRays(buffer.rays, threadRays);
+        };
+
+        parallelForWorkStealing(tileCountX * tileCountY, getThreadCount(), computeTile);
+
+        // Merge the buffers in the image
+        for (const auto& buffer : buffers)
+        {
+            addRays(statistics, buffer.rays);
+
+            for (std::size_t i = 0; i < buffer.tiles.size(); i++)
+            {
+                std::size_t minX = (buffer.tiles[i] % tileCountX) * TILE_SIZE;
+                std::size_t minY = (buffer.tiles[i] / tileCountX) * TILE_SIZE;
+                std::size_t maxX = std::min(minX + TILE_SIZE, resolution.width());
+                std::size_t maxY = std::min(minY + TILE_SIZE, resolution.height());
 
-                    color = getColor(object, point, ray, recursivity);
+                const Radiance* pixels = buffer.pixels.data() + i * TILE_SIZE * TILE_SIZE;
+                for (std::size_t y = minY; y < maxY; y++)
+                {
+                    const Radiance* row = pixels + (y - minY) * TILE_SIZE;
+                    std::copy(row, row + (maxX - minX), res.getRow(y) + minX);
                 }
             }
-
-            // Compute the pixel color
-            res->setPixel(static_cast<unsigned int>(x), static_cast<unsigned int>(y), color.toSFMLColor());
         }
 
-#ifdef PARALLELIZATION
-    });
-#else
+        return res;
+    };
+
+    Framebuffer res = renderTiles(nullptr);
+
+    if (m_sampler.has_value() && m_adaptiveAntialiasing)
+    {
+        // One ray per pixel, then the samples where needed
+        res = renderTiles(&res);
     }
-#endif
+
+    statistics.renderTime =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_renderStatistics = statistics;
 
     return res;
 }
 
 IntersectionResult Scene::getIntersectedObject(const Ray& ray) const
 {
-    std::map<std::shared_ptr<Object>, Vector3> intersections;
+    ObjectId closerObject;
+    std::optional<HitRecord> closerHit;
 
-    // Get all objects that intersect with the ray
-    for (const auto& object : m_objects)
-    {
-        auto intersection = object->getIntersection(ray);
+    // The objects skip the intersections farther than the closest one so far
+    Ray closerRay = ray;
+
+    // Returns true if the hit is the closest so far
+    auto keep = [&](ObjectId object, const std::optional<HitRecord>& hit, double& tMax) {
+        if (!hit.has_value())
+            return false;
+
+        if (Matrix::areApproximatelyEqual(hit->point, ray.getOrigin(), 0.0000001))
+            return false;
+
+        closerObject = object;
+        closerHit = hit;
+
+        tMax = hit->t;
+        closerRay.setTMax(tMax);
+
+        return true;
+    };
+
+    auto intersect = [&](ObjectId object, double& tMax) {
+        auto hit = m_objects.visit(object, [&](const auto& typedObject) { return typedObject.getHit(closerRay); });
 
-        if (intersection.has_value())
+        return keep(object, hit, tMax);
+    };
+
+    // Unbounded objects first, they give a first bound to the hierarchy traversal
+    double tMax = ray.getTMax();
+    for (ObjectId object : m_unboundedObjects)
+        intersect(object, tMax);
+
+    m_bvh.traverseLeaves(ray, tMax, [&](std::size_t begin, std::size_t count, double& bvhMax) {
+        // The spheres of the leaf at once if there are enough of them. If the closest one is ignored (at the origin
+        // of the ray), the other spheres are intersected one by one.
+        bool spheresDone = isSphereBatchLeaf(begin, count);
+        if (auto sphere = spheresDone ? m_sphereBatch.intersect(closerRay, begin, count) : std::nullopt)
         {
-            intersections[object] = intersection.value();
+            ObjectId object = m_leafObjects[sphere->slot];
+            HitRecord hit = m_objects.getObjects<Sphere>()[object.index].getHit(closerRay, sphere->t);
+
+            spheresDone = keep(object, hit, bvhMax);
         }
-    }
 
-    // Check if no intersection
-    if (intersections.empty())
+        for (std::size_t i = begin; i < begin + count; i++)
+        {
+            if (!spheresDone || m_leafObjects[i].type != ObjectId::Type::SPHERE)
+                intersect(m_leafObjects[i], bvhMax);
+        }
+
+        return false;
+    });
+
+    if (!closerHit.has_value())
         return std::nullopt;
 
-    // Get closer object
-    std::shared_ptr<Object> closerObject = nullptr;
-    Vector3& closerIntersectionPoint = intersections.begin()->second;
-    double minDistance = -1;
-    for (auto& [object, intersection] : intersections)
+    return {{closerObject, closerHit.value()}};
+}
+
+void Scene::getIntersectedObjects(RayPacket& packet,
+                                  RayPacket::Mask mask,
+                                  std::array<IntersectionResult, RayPacket::SIZE>& results) const
+{
+    std::array<ObjectId, RayPacket::SIZE> closerObjects{};
+    RayPacket::Mask hitLanes = 0;
+
+    // The objects skip the intersections farther than the closest one so far (the tMax of the lanes)
+    auto intersect = [&](ObjectId object, RayPacket::Mask lanes) {
+        RayPacket::Mask hits = m_objects.visit(object, [&](const auto& typedObject) {
+            return typedObject.getHits(packet, lanes);
+        });
+
+        hitLanes |= hits;
+        for (; hits != 0; hits &= hits - 1)
+            closerObjects[RayPacket::first(hits)] = object;
+    };
+
+    // Unbounded objects first, they give a first bound to the hierarchy traversal
+    for (ObjectId object : m_unboundedObjects)
+        intersect(object, mask);
+
+    m_bvh.traverse(packet, mask, [&](std::size_t index, RayPacket::Mask lanes) {
+        intersect(m_boundedObjects[index], lanes);
+    });
+
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
     {
-        double distance = intersection.distance(ray.getOrigin());
+        results[lane].reset();
 
-        if (Matrix::areApproximatelyEqual(intersection, ray.getOrigin(), 0.0000001))
+        if ((hitLanes >> lane & 1) == 0)
             continue;
 
-        if (distance < minDistance || minDistance == -1)
+        const HitRecord& hit = packet.hits[lane];
+        Vector3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+
+        // Rare case of an object at the origin of the ray, ignored by getIntersectedObject()
+        if (Matrix::areApproximatelyEqual(hit.point, origin, 0.0000001))
         {
-            closerObject = object;
-            closerIntersectionPoint = intersection;
-            minDistance = distance;
-        }
-    }
+            Ray ray = packet.getRay(lane);
+            ray.setTMax(std::numeric_limits<double>::infinity());
 
-    if (closerObject == nullptr)
-        return std::nullopt;
+            results[lane] = getIntersectedObject(ray);
+            continue;
+        }
 
-    return {{closerObject, closerIntersectionPoint}};
+        results[lane] = {{closerObjects[lane], hit}};
+    }
 }
 
 double lightAttenuation(double distance)
@@ -466,15 +824,18 @@ double lightAttenuation(double distance)
     return 1.0 / (b * distance + c * pow2(distance));
 }
 
-std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& intersectionObject,
-                                             const Vector3& intersectionPoint,
-                                             const Ray& primaryRay) const
+std::pair<double, Radiance> Scene::computeLight(ObjectId intersectionObject,
+                                                const HitRecord& hit,
+                                                const Ray& primaryRay) const
 {
+    const Object& object = m_objects.get(intersectionObject);
+    const Vector3& intersectionPoint = hit.point;
+
     /* Light global illumination */
     double i = 0;
 
     /* Light colors */
-    Color color;
+    Radiance color;
 
     for (const auto& light : m_lights)
     {
@@ -486,7 +847,7 @@ std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& inte
         if (!origin.has_value())
             continue;
 
-        auto ray = intersectionObject->getSecondaryRay(intersectionPoint, origin.value());
+        auto ray = object.getSecondaryRay(intersectionPoint, origin.value());
 
         if (!ray.has_value())
             continue;
@@ -498,7 +859,7 @@ std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& inte
         double attenuation = lightAttenuation(origin->distance(ray->getOrigin()) * (1.0 / light->getIntensity()));
 
         // N
-        Vector3 n = intersectionObject->getNormal(intersectionPoint);
+        const Vector3& n = hit.normal;
 
         // H
         Vector3 h = ray->getDirection() + primaryRay.getDirection();
@@ -508,7 +869,7 @@ std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& inte
         Vector3 l = ray->getDirection();
 
         // Alpha/n
-        const double shininess = intersectionObject->getMaterial().shininess();
+        const double shininess = object.getMaterial().shininess();
 
         /* Specular */
         double is = std::max<double>(std::pow(Matrix::dot(n, h), shininess), 0.) * attenuation;
@@ -517,7 +878,7 @@ std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& inte
         double id = Matrix::dot(n, l) * attenuation;
 
         i += is + id;
-        color += light->getColor() * light->getIntensity() * attenuation;
+        color += Radiance(light->getColor()) * (light->getIntensity() * attenuation);
     }
 
     return {i, color};
@@ -525,64 +886,81 @@ std::pair<double, Color> Scene::computeLight(const std::shared_ptr<Object>& inte
 
 bool Scene::isIlluminated(const Ray& secondaryRay, const Vector3& lightOrigin) const
 {
-    std::map<std::shared_ptr<Object>, Vector3> intersections;
-
     // Change the origin of the secondary to the light origin, the direction stay the same
     // It will allow to handle the case we need to gow throw a sphere (other extremity of a sphere)
     Ray ray(lightOrigin, secondaryRay.getDirection() * -1, secondaryRay.getType());
+    threadRays.shadowRayCount++;
 
     // The intersection point
     const auto& intersectionPoint = secondaryRay.getOrigin();
 
-    // Get all objects that intersect with the ray
-    for (const auto& object : m_objects)
-    {
-        auto intersection = object->getIntersection(ray);
-        if (intersection.has_value())
-        {
-            intersections[object] = intersection.value();
-        }
-    }
-
-    // Check if no intersection
-    if (intersections.empty())
-        return true;
+    // The blockers are between the light and the intersection point
+    ray.setTMax(ray.getParameter(intersectionPoint));
 
     // Distance to the light (from the intersection point)
     double lightDistance = lightOrigin.distance(intersectionPoint);
 
-    // Get closer object
-    for (auto& element : intersections) // NOLINT
-    {
-        auto& intersection = element.second;
+    // Any object hit closer to the light than the intersection point is a blocker, no need to find the closest one
+    auto isBlockingHit = [&](const std::optional<HitRecord>& hit) {
+        if (!hit.has_value())
+            return false;
 
         // Distance to the light (from the newly found intersection point)
-        double distance = lightOrigin.distance(intersection);
+        double distance = lightOrigin.distance(hit->point);
 
         if (areDoubleApproximatelyEqual(distance, lightDistance, 0.0000001))
-            continue;
+            return false;
+
+        return distance < lightDistance;
+    };
+
+    auto isBlocking = [&](ObjectId object) {
+        return isBlockingHit(m_objects.visit(object, [&](const auto& typedObject) { return typedObject.getHit(ray); }));
+    };
 
-        if (distance < lightDistance)
+    for (ObjectId object : m_unboundedObjects)
+    {
+        if (isBlocking(object))
             return false;
     }
 
-    return true;
+    bool blocked = false;
+    m_bvh.traverseLeaves(ray, ray.getTMax(), [&](std::size_t begin, std::size_t count, [[maybe_unused]] double& tMax) {
+        // The closest sphere of the leaf decides for all its spheres, the other ones are farther from the light
+        bool batched = isSphereBatchLeaf(begin, count);
+        if (auto sphere = batched ? m_sphereBatch.intersect(ray, begin, count) : std::nullopt)
+        {
+            const Sphere& object = m_objects.getObjects<Sphere>()[m_leafObjects[sphere->slot].index];
+            blocked = isBlockingHit(object.getHit(ray, sphere->t));
+        }
+
+        for (std::size_t i = begin; i < begin + count && !blocked; i++)
+        {
+            if (!batched || m_leafObjects[i].type != ObjectId::Type::SPHERE)
+                blocked = isBlocking(m_leafObjects[i]);
+        }
+
+        return blocked;
+    });
+
+    return !blocked;
 }
 
-std::optional<Color> Scene::computeReflection(const std::shared_ptr<Object>& intersectionObject,
-                                              const Vector3& intersectionPoint,
-                                              const Ray& primaryRay,
-                                              unsigned int recursivity) const
+std::optional<Radiance> Scene::computeReflection(ObjectId intersectionObject,
+                                                 const HitRecord& hit,
+                                                 const Ray& primaryRay,
+                                                 unsigned int recursivity) const
 {
-    if (intersectionObject->getMaterial().isOpaque())
+    if (m_objects.get(intersectionObject).getMaterial().isOpaque())
         return std::nullopt;
 
     // Get reflected direction
-    auto reflectedDirection = Matrix::reflection(primaryRay.getDirection(),                         // Primary direction
-                                                 intersectionObject->getNormal(intersectionPoint)); // Normal
+    auto reflectedDirection = Matrix::reflection(primaryRay.getDirection(), // Primary direction
+                                                 hit.normal);               // Normal
 
     // Create the reflected ray
-    Ray reflectedRay(intersectionPoint, reflectedDirection, PRIMARY);
+    Ray reflectedRay(hit.point, reflectedDirection, PRIMARY);
+    threadRays.reflectionRayCount++;
 
     // Result of the reflection
     auto reflectionResult = getIntersectedObject(reflectedRay);
@@ -595,25 +973,27 @@ std::optional<Color> Scene::computeReflection(const std::shared_ptr<Object>& int
     if (recursivity != 0)
         return getColor(reflectedObject, reflectedIntersection, reflectedRay, recursivity - 1);
 
-    return reflectedObject->getColor();
+    return Radiance(m_objects.get(reflectedObject).getColor());
 }
 
-std::optional<Color> Scene::computeRefraction(const std::shared_ptr<Object>& intersectionObject,
-                                              const Vector3& intersectionPoint,
-                                              const Ray& primaryRay,
-                                              unsigned int recursivity) const
+std::optional<Radiance> Scene::computeRefraction(ObjectId intersectionObject,
+                                                 const HitRecord& hit,
+                                                 const Ray& primaryRay,
+                                                 unsigned int recursivity) const
 {
-    if (!intersectionObject->getMaterial().isTransparent())
+    Material material = m_objects.get(intersectionObject).getMaterial();
+    if (!material.isTransparent())
         return std::nullopt;
 
     // Get refracted direction
-    auto refractedDirection = Matrix::refraction(primaryRay.getDirection(),                        // Primary direction
-                                                 intersectionObject->getNormal(intersectionPoint), // Normal
+    auto refractedDirection = Matrix::refraction(primaryRay.getDirection(), // Primary direction
+                                                 hit.normal,                // Normal
                                                  1.0,
-                                                 intersectionObject->getMaterial().refractivity()); // Refractivity
+                                                 material.refractivity()); // Refractivity
 
     // Create the reflected ray
-    Ray refractedRay(intersectionPoint, refractedDirection, PRIMARY);
+    Ray refractedRay(hit.point, refractedDirection, PRIMARY);
+    threadRays.refractionRayCount++;
 
     // Result of the reflection
     auto reflectionResult = getIntersectedObject(refractedRay);
@@ -626,12 +1006,13 @@ std::optional<Color> Scene::computeRefraction(const std::shared_ptr<Object>& int
     if (reflectedObject == intersectionObject)
     {
         refractedDirection = Matrix::refraction(refractedRay.getDirection(),
-                                                reflectedObject->getNormal(reflectedIntersection) * -1,
-                                                reflectedObject->getMaterial().refractivity(),
+                                                reflectedIntersection.normal * -1,
+                                                m_objects.get(reflectedObject).getMaterial().refractivity(),
                                                 1.0);
 
         // Create the reflected ray
-        refractedRay = Ray(reflectedIntersection, refractedDirection, PRIMARY);
+        refractedRay = Ray(reflectedIntersection.point, refractedDirection, PRIMARY);
+        threadRays.refractionRayCount++;
 
         // Result of the reflection
         reflectionResult = getIntersectedObject(refractedRay);
@@ -645,23 +1026,29 @@ std::optional<Color> Scene::computeRefraction(const std::shared_ptr<Object>& int
     if (recursivity != 0)
         return getColor(reflectedObject, reflectedIntersection, refractedRay, recursivity - 1);
 
-    return reflectedObject->getColor();
+    return Radiance(m_objects.get(reflectedObject).getColor());
 }
 
-Color Scene::getColor(const std::shared_ptr<Object>& intersectionObject,
-                      const Vector3& intersectionPoint,
-                      const Ray& primaryRay,
-                      unsigned int recursivity) const
+Radiance Scene::getColor(ObjectId intersectionObject,
+                         const HitRecord& hit,
+                         const Ray& primaryRay,
+                         unsigned int recursivity) const
 {
-    double r = intersectionObject->getMaterial().reflectivity();
-    double t = intersectionObject->getMaterial().transparency();
+    const Object& object = m_objects.get(intersectionObject);
+    double r = object.getMaterial().reflectivity();
+    double t = object.getMaterial().transparency();
+
+    auto light = computeLight(intersectionObject, hit, primaryRay);
+    auto reflection = computeReflection(intersectionObject, hit, primaryRay, recursivity);
+    auto refraction = computeRefraction(intersectionObject, hit, primaryRay, recursivity);
+
+    Radiance objectColor(object.getColor());
 
-    auto light = computeLight(intersectionObject, intersectionPoint, primaryRay);
-    auto reflection = computeReflection(intersectionObject, intersectionPoint, primaryRay, recursivity);
-    auto refraction = computeRefraction(intersectionObject, intersectionPoint, primaryRay, recursivity);
+    // Lights behind the surface don't darken it
+    double intensity = std::max(light.first, 0.0);
 
-    Color color = intersectionObject->getColor() * m_ambientLight +
-                  intersectionObject->getColor() * (1 - m_ambientLight) * light.first + light.second * light.first;
+    Radiance color = objectColor * m_ambientLight + objectColor * ((1 - m_ambientLight) * intensity) +
+                     light.second * intensity;
 
     // Set the color
     if (reflection.has_value())
@@ -671,7 +1058,7 @@ Color Scene::getColor(const std::shared_ptr<Object>& intersectionObject,
     if (refraction.has_value())
         color = color * (1 - t) + refraction.value() * t;
     else
-        color = color * (1 - t) + m_backgroundColor * t;
+        color = color * (1 - t) + Radiance(m_backgroundColor) * t;
 
     return color;
 }
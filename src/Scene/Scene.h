@@ -1,19 +1,28 @@
 #ifndef H_RAYTRACING_SCENE_H
 #define H_RAYTRACING_SCENE_H
 
+#include "Accelerators/BVH.h"
+#include "Accelerators/SphereBatch.h"
 #include "Camera/Camera.h"
+#include "Config.h"
 #include "Light/Light.h"
-#include "Objects/Object.h"
+#include "ObjectStorage.h"
+#include "Samplers/Sampler.h"
+#include "Utils/Framebuffer.h"
+#include "Utils/Radiance.h"
+#include "Utils/RayPacket.h"
 
-#include <SFML/Graphics/Image.hpp>
+#include <array>
+#include <cstdint>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <vector>
 
-using IntersectionResult = std::optional<std::pair<std::shared_ptr<Object>, Vector3>>;
+using IntersectionResult = std::optional<std::pair<ObjectId, HitRecord>>;
 
 /**
  * @brief Core class to store objects and primitives (like camera).
@@ -50,7 +59,7 @@ public:
     /**
      * @brief Add an object to the scene.
      *
-     * @tparam T The type to create.
+     * @tparam T The type to create (Sphere, Plane, Triangle or Model, see ObjectStorage).
      *
      * @param args Args to use to create the object T.
      *
@@ -59,11 +68,19 @@ public:
     template<typename T, typename... Args>
     Scene& addObject(Args... args)
     {
-        m_objects.push_back(std::make_shared<T>(args...));
+        m_objects.add<T>(args...);
+        m_bvhOutdated = true;
 
         return *this;
     }
 
+    /**
+     * @brief Get the objects of the scene.
+     *
+     * @return Returns the objects, referenced by the intersection results.
+     */
+    const ObjectStorage& getObjects() const;
+
     /**
      * @brief Create a camera for the scene.
      *
@@ -84,6 +101,24 @@ public:
      */
     void loadScene(const std::string& path);
 
+    /**
+     * @brief Build the bounding volume hierarchy over the objects of the scene.
+     *
+     * Called at the end of loadScene(). Objects added afterwards with addObject() trigger a new build before the
+     * next render.
+     */
+    void buildBVH();
+
+    /**
+     * @brief Check if the spheres of a BVH leaf are intersected with the sphere batch (enough spheres in the leaf).
+     *
+     * @param begin The first object of the leaf in m_leafObjects.
+     * @param count The number of objects of the leaf.
+     *
+     * @return Returns true if the leaf has at least SphereBatch::MIN_SPHERES spheres.
+     */
+    bool isSphereBatchLeaf(std::size_t begin, std::size_t count) const;
+
     /**
      * @brief Split a material element of the config file.
      *
@@ -123,67 +158,171 @@ public:
     /**
      * @brief Generate an image from the scene.
      *
-     * @param light       The light to add.
+     * @param imagePath   The path of the image, its extension gives the format (see ImageWriter).
      * @param recursivity Recursivity used for reflection and refraction computation (default 1).
      *
      * @return Returns *this.
      */
     Scene& generate(const std::string& imagePath, unsigned int recursivity = 1);
 
+#ifdef SFML_VIEWER
     /**
      * @brief Show last generated image (if empty, will generate one).
      *
+     * Only available when built with SFML_VIEWER (see Config.h).
+     *
      * @return Returns *this.
      */
     Scene& show();
+#endif
 
     /**
      * @brief Enable anti-aliasing.
      *
-     * @param antialiasingSampling Anti-aliasing sampling value (4, 8 or 16).
+     * The render time is about proportional to the number of samples per pixel. In adaptive mode, the image is first
+     * rendered with one ray per pixel, then only the pixels contrasting with their neighbours (the edges, the shadow
+     * borders, ...) are sampled, so the flat areas cost one ray per pixel.
+     *
+     * @param samplesPerPixel The number of samples (rays) per pixel (per sampled pixel in adaptive mode).
+     * @param pattern         The positions of the samples in the pixels.
+     * @param adaptive        True to only sample the pixels which need it.
      */
-    void enableAntialiasing(std::size_t antialiasingSampling = 4);
+    void enableAntialiasing(std::size_t samplesPerPixel = 4,
+                            Sampler::Pattern pattern = Sampler::Pattern::STRATIFIED,
+                            bool adaptive = false);
 
     /**
      * @brief Disable anti-aliasing.
      */
     void disableAntialiasing();
 
+    /**
+     * @brief Set the number of threads used to render the image.
+     *
+     * Only used when built with PARALLELIZATION (see Config.h), the render is single threaded otherwise.
+     *
+     * @param threadCount The number of threads (0 to use all the hardware threads).
+     */
+    void setThreadCount(std::size_t threadCount);
+
+    /**
+     * @brief Get the number of threads used to render the image.
+     *
+     * @return Returns the number of threads (1 if built without PARALLELIZATION).
+     */
+    std::size_t getThreadCount() const;
+
+    /**
+     * @brief Trace the primary rays in packets (enabled by default).
+     *
+     * The rays of neighbouring pixels (blocks of PACKET_BLOCK_SIZE * PACKET_BLOCK_SIZE pixels) are intersected
+     * together with the SIMD kernels (see RayPacket), the image is the same as with one ray at a time.
+     *
+     * @param packetTracing True to trace the primary rays in packets, false to trace them one by one.
+     */
+    void setPacketTracing(bool packetTracing);
+
+    /**
+     * @struct RenderStatistics
+     * @brief Statistics of the last render.
+     */
+    struct RenderStatistics
+    {
+        std::uint64_t primaryRayCount = 0;    /*!< Number of rays from the camera. */
+        std::uint64_t shadowRayCount = 0;     /*!< Number of rays toward the lights. */
+        std::uint64_t reflectionRayCount = 0; /*!< Number of reflected rays. */
+        std::uint64_t refractionRayCount = 0; /*!< Number of refracted rays (entering and leaving the objects). */
+        std::size_t threadCount = 0;          /*!< Number of threads of the render. */
+        double renderTime = 0.0;              /*!< Render time in milliseconds. */
+
+        /**
+         * @brief Get the number of rays of every type.
+         *
+         * @return Returns the total number of rays.
+         */
+        std::uint64_t getRayCount() const
+        {
+            return primaryRayCount + shadowRayCount + reflectionRayCount + refractionRayCount;
+        }
+    };
+
+    /**
+     * @brief Get the statistics of the last render.
+     *
+     * @return Returns the render statistics.
+     */
+    const RenderStatistics& getRenderStatistics() const;
+
 protected:
     /**
-     * @brief Make the computation and get the corresponding image.
+     * The size (in pixels) of the square tiles rendered by the threads.
+     */
+    static constexpr std::size_t TILE_SIZE = 16;
+
+    /**
+     * The contrast (biggest channel difference with a neighbour, from 0 to 1) above which a pixel is sampled in
+     * adaptive anti-aliasing.
+     */
+    static constexpr double ADAPTIVE_ANTIALIASING_CONTRAST = 0.1;
+
+    /**
+     * The size (in pixels) of the square blocks whose primary rays are traced as a packet.
+     */
+    static constexpr std::size_t PACKET_BLOCK_SIZE = 4;
+
+    static_assert(PACKET_BLOCK_SIZE * PACKET_BLOCK_SIZE == RayPacket::SIZE, "A block fills a packet");
+
+    /**
+     * @brief Make the computation.
+     *
+     * The image is split in tiles, distributed over the threads with work stealing (see getThreadCount()).
      *
      * @param recursivity Recursivity used for reflection and refraction computation.
      *
-     * @return Returns the generated image.
+     * @return Returns the radiance of each pixel.
      */
-    std::shared_ptr<sf::Image> compute(unsigned int recursivity = 1) const;
+    Framebuffer compute(unsigned int recursivity = 1) const;
 
     /**
      * @brief Get the intersected object and intersection point by a primary ray.
      *
      * @param ray The primary ray to use.
      *
-     * @return Returns the intersected object and point.
+     * @return Returns the intersected object and the hit record.
      */
     IntersectionResult getIntersectedObject(const Ray& ray) const;
 
+    /**
+     * @brief Get the intersected objects and intersection points of the primary rays of a packet.
+     *
+     * Same results as getIntersectedObject() for each ray, the tMax of the lanes are lowered to their hit.
+     *
+     * @param packet  The primary rays to use.
+     * @param mask    The lanes to use.
+     * @param results The intersected object and the hit record of each lane (nothing for the other lanes).
+     */
+    void getIntersectedObjects(RayPacket& packet,
+                               RayPacket::Mask mask,
+                               std::array<IntersectionResult, RayPacket::SIZE>& results) const;
+
     /**
      * @brief Compute the light impact on the object color.
      *
      * @param intersectionObject The intersected object.
-     * @param intersectionPoint  The intersection point.
+     * @param hit                The intersection.
      * @param primaryRay         The primary ray.
      *
      * @return Returns the combined intensity and colors of all lights.
      */
-    std::pair<double, Color> computeLight(const std::shared_ptr<Object>& intersectionObject,
-                                          const Vector3& intersectionPoint,
-                                          const Ray& primaryRay) const;
+    std::pair<double, Radiance> computeLight(ObjectId intersectionObject,
+                                             const HitRecord& hit,
+                                             const Ray& primaryRay) const;
 
     /**
      * @brief Check if the intersection point is illuminated.
      *
+     * Any-hit query: the search stops at the first object found between the light and the intersection point.
+     *
      * @warning Need to have the intersection point as the secondary ray origin.
      *
      * @param secondaryRay The secondary ray to use. See the warning above.
@@ -197,52 +336,112 @@ protected:
      * @brief Compute the reflection impact on the object color.
      *
      * @param intersectionObject The intersected object.
-     * @param intersectionPoint  The intersection point.
+     * @param hit                The intersection.
      * @param primaryRay         The primary ray.
      *
      * @return Returns the color (to add with the object color).
      */
-    std::optional<Color> computeReflection(const std::shared_ptr<Object>& intersectionObject,
-                                           const Vector3& intersectionPoint,
-                                           const Ray& primaryRay,
-                                           unsigned int recursivity = 0) const;
+    std::optional<Radiance> computeReflection(ObjectId intersectionObject,
+                                              const HitRecord& hit,
+                                              const Ray& primaryRay,
+                                              unsigned int recursivity = 0) const;
 
     /**
      * @brief Compute the refraction impact on the object color.
      *
      * @param intersectionObject The intersected object.
-     * @param intersectionPoint  The intersection point.
+     * @param hit                The intersection.
      * @param primaryRay         The primary ray.
      *
      * @return Returns the color (to add with the object color).
      */
-    std::optional<Color> computeRefraction(const std::shared_ptr<Object>& intersectionObject,
-                                           const Vector3& intersectionPoint,
-                                           const Ray& primaryRay,
-                                           unsigned int recursivity = 0) const;
+    std::optional<Radiance> computeRefraction(ObjectId intersectionObject,
+                                              const HitRecord& hit,
+                                              const Ray& primaryRay,
+                                              unsigned int recursivity = 0) const;
 
     /**
      * @brief Function (with recursivity) to get the color of an intersected object.
      *
      * @param intersectionObject The intersection object.
-     * @param intersectionPoint  The intersection point.
+     * @param hit                The intersection.
      * @param primaryRay         The primary ray.
      * @param recursivity        The level of recursivity (default 0 = no recursivity).
      *
      * @return Returns the color of the intersected object.
      */
-    Color getColor(const std::shared_ptr<Object>& intersectionObject,
-                   const Vector3& intersectionPoint,
-                   const Ray& primaryRay,
-                   unsigned int recursivity = 0) const;
+    Radiance getColor(ObjectId intersectionObject,
+                      const HitRecord& hit,
+                      const Ray& primaryRay,
+                      unsigned int recursivity = 0) const;
 
 private:
     std::shared_ptr<Camera> m_camera;
     std::vector<std::shared_ptr<Light>> m_lights;
-    std::vector<std::shared_ptr<Object>> m_objects;
+
+    /**
+     * The objects, stored by type.
+     */
+    ObjectStorage m_objects;
+
+    /**
+     * The bounded objects, referenced by the BVH leaves.
+     */
+    std::vector<ObjectId> m_boundedObjects;
+
+    /**
+     * The unbounded objects (like planes), tested for every ray.
+     */
+    std::vector<ObjectId> m_unboundedObjects;
+
+    /**
+     * The hierarchy over m_boundedObjects.
+     */
+    BVH m_bvh;
+
+    /**
+     * The bounded objects in the order of the BVH leaves (see BVH::traverseLeaves()).
+     */
+    std::vector<ObjectId> m_leafObjects;
+
+    /**
+     * The bounded spheres in the order of the BVH leaves (empty slots for the other objects), so that the spheres of
+     * a leaf are intersected at once by the single rays.
+     */
+    SphereBatch m_sphereBatch;
+
+    /**
+     * True if objects were added since the last BVH build.
+     */
+    bool m_bvhOutdated = false;
     Color m_backgroundColor = Colors::black();
-    std::string m_lastSavedImage;
-    std::size_t m_antialiasingSampling = 0;
+
+    /**
+     * The last generated image.
+     */
+    std::optional<Framebuffer> m_lastImage;
+
+    /**
+     * The anti-aliasing sampler, if enabled.
+     */
+    std::optional<Sampler> m_sampler;
+
+    /**
+     * True to only sample the pixels with contrast.
+     */
+    bool m_adaptiveAntialiasing = false;
+
+    /**
+     * True to trace the primary rays in packets.
+     */
+    bool m_packetTracing = true;
+
+    /**
+     * The statistics of the last render (updated by the render, which doesn't change the scene).
+     */
+    mutable RenderStatistics m_renderStatistics;
+
+    std::size_t m_threadCount = 0;
     double m_ambientLight;
 };
 
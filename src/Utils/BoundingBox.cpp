@@ -0,0 +1,192 @@
+#include "BoundingBox.h"
+
+#include "Simd.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /**
+     * @brief Slab test of every lane of a packet, the result of each lane is 1 (hit) or 0.
+     */
+    SIMD_CLONES void intersectLanes(const Vector3& min,
+                                    const Vector3& max,
+                                    const RayPacket& packet,
+                                    std::array<std::int64_t, RayPacket::SIZE>& hits)
+    {
+        const double minX = min.x();
+        const double minY = min.y();
+        const double minZ = min.z();
+        const double maxX = max.x();
+        const double maxY = max.y();
+        const double maxZ = max.z();
+
+        for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        {
+            double t0 = (minX - packet.originX[i]) * packet.inverseDirectionX[i];
+            double t1 = (maxX - packet.originX[i]) * packet.inverseDirectionX[i];
+
+            double near = std::min(t0, t1);
+            double far = std::max(t0, t1);
+
+            t0 = (minY - packet.originY[i]) * packet.inverseDirectionY[i];
+            t1 = (maxY - packet.originY[i]) * packet.inverseDirectionY[i];
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+
+            t0 = (minZ - packet.originZ[i]) * packet.inverseDirectionZ[i];
+            t1 = (maxZ - packet.originZ[i]) * packet.inverseDirectionZ[i];
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+
+            far *= 1.0 + 4.0 * std::numeric_limits<double>::epsilon();
+
+            // Without branch, so that the loop is vectorized
+            hits[i] = !((near > far) | (far < 0.0) | (near > packet.tMax[i]));
+        }
+    }
+} // namespace
+
+BoundingBox::BoundingBox()
+    : m_min(std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity()),
+      m_max(-std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity())
+{
+}
+
+BoundingBox::BoundingBox(const Vector3& min, const Vector3& max) : m_min(min), m_max(max)
+{
+}
+
+BoundingBox BoundingBox::infinite()
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    return BoundingBox(Vector3(-infinity, -infinity, -infinity), Vector3(infinity, infinity, infinity));
+}
+
+const Vector3& BoundingBox::min() const
+{
+    return m_min;
+}
+
+const Vector3& BoundingBox::max() const
+{
+    return m_max;
+}
+
+void BoundingBox::extend(const Vector3& point)
+{
+    m_min.setX(std::min(m_min.x(), point.x()));
+    m_min.setY(std::min(m_min.y(), point.y()));
+    m_min.setZ(std::min(m_min.z(), point.z()));
+
+    m_max.setX(std::max(m_max.x(), point.x()));
+    m_max.setY(std::max(m_max.y(), point.y()));
+    m_max.setZ(std::max(m_max.z(), point.z()));
+}
+
+void BoundingBox::extend(const BoundingBox& box)
+{
+    extend(box.m_min);
+    extend(box.m_max);
+}
+
+Vector3 BoundingBox::center() const
+{
+    return Vector3((m_min.x() + m_max.x()) * 0.5, (m_min.y() + m_max.y()) * 0.5, (m_min.z() + m_max.z()) * 0.5);
+}
+
+double BoundingBox::extent(std::size_t axis) const
+{
+    switch (axis)
+    {
+        case 0:
+            return m_max.x() - m_min.x();
+        case 1:
+            return m_max.y() - m_min.y();
+        default:
+            return m_max.z() - m_min.z();
+    }
+}
+
+std::size_t BoundingBox::largestAxis() const
+{
+    double x = extent(0);
+    double y = extent(1);
+    double z = extent(2);
+
+    if (x >= y && x >= z)
+        return 0;
+
+    if (y >= z)
+        return 1;
+
+    return 2;
+}
+
+double BoundingBox::surfaceArea() const
+{
+    if (isEmpty())
+        return 0.0;
+
+    double x = extent(0);
+    double y = extent(1);
+    double z = extent(2);
+
+    return 2.0 * (x * y + y * z + z * x);
+}
+
+bool BoundingBox::isEmpty() const
+{
+    return m_min.x() > m_max.x() || m_min.y() > m_max.y() || m_min.z() > m_max.z();
+}
+
+bool BoundingBox::intersect(const Vector3& origin, const Vector3& inverseDirection, double tMax, double& tNear) const
+{
+    double t0 = (m_min.x() - origin.x()) * inverseDirection.x();
+    double t1 = (m_max.x() - origin.x()) * inverseDirection.x();
+
+    double near = std::min(t0, t1);
+    double far = std::max(t0, t1);
+
+    t0 = (m_min.y() - origin.y()) * inverseDirection.y();
+    t1 = (m_max.y() - origin.y()) * inverseDirection.y();
+
+    near = std::max(near, std::min(t0, t1));
+    far = std::min(far, std::max(t0, t1));
+
+    t0 = (m_min.z() - origin.z()) * inverseDirection.z();
+    t1 = (m_max.z() - origin.z()) * inverseDirection.z();
+
+    near = std::max(near, std::min(t0, t1));
+    far = std::min(far, std::max(t0, t1));
+
+    // Robustness factor so that rays grazing a face are not lost to rounding errors
+    far *= 1.0 + 4.0 * std::numeric_limits<double>::epsilon();
+
+    if (near > far || far < 0.0 || near > tMax)
+        return false;
+
+    tNear = near;
+
+    return true;
+}
+
+RayPacket::Mask BoundingBox::intersect(const RayPacket& packet, RayPacket::Mask mask) const
+{
+    std::array<std::int64_t, RayPacket::SIZE> hits;
+    intersectLanes(m_min, m_max, packet, hits);
+
+    RayPacket::Mask res = 0;
+    for (std::size_t i = 0; i < RayPacket::SIZE; i++)
+        res |= static_cast<RayPacket::Mask>(hits[i]) << i;
+
+    return res & mask;
+}
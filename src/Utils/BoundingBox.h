@@ -0,0 +1,144 @@
+#ifndef H_RAYTRACING_BOUNDINGBOX_H
+#define H_RAYTRACING_BOUNDINGBOX_H
+
+#include "RayPacket.h"
+#include "Vector3.h"
+
+#include <cstddef>
+
+/**
+ * @class BoundingBox
+ * @brief Axis-aligned bounding box.
+ *
+ * Used by the acceleration structures to quickly discard the objects that can't be hit by a ray.
+ * A default constructed box is empty (min > max) and can be grown with extend().
+ *
+ * @see Vector3, BVH
+ */
+class BoundingBox
+{
+public:
+    /**
+     * @brief Create an empty bounding box.
+     */
+    BoundingBox();
+
+    /**
+     * @brief Create a bounding box from its two corners.
+     *
+     * @param min The minimum corner.
+     * @param max The maximum corner.
+     */
+    BoundingBox(const Vector3& min, const Vector3& max);
+
+    /**
+     * @brief Create a bounding box that contains the whole space (used by infinite objects like planes).
+     *
+     * @return Returns an infinite bounding box.
+     */
+    static BoundingBox infinite();
+
+    /**
+     * @brief Get the minimum corner of the box.
+     *
+     * @return Returns the minimum corner.
+     */
+    const Vector3& min() const;
+
+    /**
+     * @brief Get the maximum corner of the box.
+     *
+     * @return Returns the maximum corner.
+     */
+    const Vector3& max() const;
+
+    /**
+     * @brief Grow the box to contain a point.
+     *
+     * @param point The point to include.
+     */
+    void extend(const Vector3& point);
+
+    /**
+     * @brief Grow the box to contain another box.
+     *
+     * @param box The box to include.
+     */
+    void extend(const BoundingBox& box);
+
+    /**
+     * @brief Get the center of the box.
+     *
+     * @return Returns the center point.
+     */
+    Vector3 center() const;
+
+    /**
+     * @brief Get the size of the box on a given axis.
+     *
+     * @param axis The axis (0 = x, 1 = y, 2 = z).
+     *
+     * @return Returns the extent of the box on this axis.
+     */
+    double extent(std::size_t axis) const;
+
+    /**
+     * @brief Get the axis on which the box is the largest.
+     *
+     * @return Returns the axis (0 = x, 1 = y, 2 = z).
+     */
+    std::size_t largestAxis() const;
+
+    /**
+     * @brief Get the surface area of the box.
+     *
+     * @return Returns the surface area (0 for an empty box).
+     */
+    double surfaceArea() const;
+
+    /**
+     * @brief Know if the box is empty (nothing was added).
+     *
+     * @return Returns true if the box is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Slab test between a ray and the box.
+     *
+     * The ray is given with its inverse direction so that it can be computed once per ray.
+     *
+     * @param origin           The origin of the ray.
+     * @param inverseDirection The inverse (1/x, 1/y, 1/z) of the ray direction.
+     * @param tMax             The maximum ray parameter accepted.
+     * @param tNear            The ray parameter where the ray enters the box (if there is an intersection).
+     *
+     * @return Returns true if the ray intersects the box in [0, tMax], false otherwise.
+     */
+    bool intersect(const Vector3& origin, const Vector3& inverseDirection, double tMax, double& tNear) const;
+
+    /**
+     * @brief Slab test between the rays of a packet and the box (SIMD kernel).
+     *
+     * The same test as the one of a single ray, for every lane at once.
+     *
+     * @param packet The rays, with their current tMax.
+     * @param mask   The lanes to test.
+     *
+     * @return Returns the lanes of the mask intersecting the box in [0, tMax].
+     */
+    RayPacket::Mask intersect(const RayPacket& packet, RayPacket::Mask mask) const;
+
+private:
+    /**
+     * The minimum corner of the box.
+     */
+    Vector3 m_min;
+
+    /**
+     * The maximum corner of the box.
+     */
+    Vector3 m_max;
+};
+
+#endif //H_RAYTRACING_BOUNDINGBOX_H
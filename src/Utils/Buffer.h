@@ -0,0 +1,138 @@
+#ifndef H_RAYTRACING_BUFFER_H
+#define H_RAYTRACING_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Buffer
+ * @brief Read-only array, either owning its elements or viewing elements stored elsewhere.
+ *
+ * Used for the big geometry arrays, which are either computed (owned) or used in place from a memory-mapped cache
+ * file (viewed). A viewing buffer keeps the owner of the memory (like the mapped file) alive.
+ *
+ * @tparam T The element type (trivially copyable when viewing a file).
+ */
+template<typename T>
+class Buffer
+{
+public:
+    /**
+     * @brief Create an empty buffer.
+     */
+    Buffer() = default;
+
+    /**
+     * @brief Create a buffer owning its elements.
+     *
+     * @param elements The elements.
+     */
+    explicit Buffer(std::vector<T> elements)
+        : m_elements(std::move(elements)),
+          m_data(m_elements.data()),
+          m_size(m_elements.size())
+    {
+    }
+
+    /**
+     * @brief Create a buffer viewing elements owned by another object.
+     *
+     * @param data  The first element.
+     * @param size  The number of elements.
+     * @param owner The owner of the elements, kept alive by the buffer.
+     */
+    Buffer(const T* data, std::size_t size, std::shared_ptr<const void> owner)
+        : m_data(data),
+          m_size(size),
+          m_owner(std::move(owner))
+    {
+    }
+
+    Buffer(const Buffer& buffer)
+        : m_elements(buffer.m_elements),
+          m_data(buffer.m_owner ? buffer.m_data : m_elements.data()),
+          m_size(buffer.m_size),
+          m_owner(buffer.m_owner)
+    {
+    }
+
+    Buffer(Buffer&& buffer) noexcept
+        : m_elements(std::move(buffer.m_elements)),
+          m_data(std::exchange(buffer.m_data, nullptr)),
+          m_size(std::exchange(buffer.m_size, 0)),
+          m_owner(std::move(buffer.m_owner))
+    {
+    }
+
+    ~Buffer() = default;
+
+    Buffer& operator=(Buffer buffer) noexcept
+    {
+        std::swap(m_elements, buffer.m_elements);
+        std::swap(m_data, buffer.m_data);
+        std::swap(m_size, buffer.m_size);
+        std::swap(m_owner, buffer.m_owner);
+
+        return *this;
+    }
+
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const T* begin() const
+    {
+        return m_data;
+    }
+
+    const T* end() const
+    {
+        return m_data + m_size;
+    }
+
+    const T& front() const
+    {
+        return m_data[0];
+    }
+
+    const T& operator[](std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+private:
+    /**
+     * The elements, if owned.
+     */
+    std::vector<T> m_elements;
+
+    /**
+     * The first element (owned or not).
+     */
+    const T* m_data = nullptr;
+
+    /**
+     * The number of elements.
+     */
+    std::size_t m_size = 0;
+
+    /**
+     * The owner of the elements if not owned.
+     */
+    std::shared_ptr<const void> m_owner;
+};
+
+#endif //H_RAYTRACING_BUFFER_H
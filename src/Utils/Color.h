@@ -1,9 +1,12 @@
 #ifndef H_RAYTRACING_COLOR_H
 #define H_RAYTRACING_COLOR_H
 
+#include "Config.h"
 #include "Vector3.h"
 
+#ifdef SFML_VIEWER
 #include <SFML/Graphics/Color.hpp>
+#endif
 #include <cstdint>
 #include <iostream>
 
@@ -137,6 +140,7 @@ struct Color
         return *this;
     }
 
+#ifdef SFML_VIEWER
     /**
      * @brief Convert the color to sf::Color.
      */
@@ -144,6 +148,7 @@ struct Color
     {
         return sf::Color(m_red, m_green, m_blue, 255);
     }
+#endif
 
     /**
      * @brief Print color.
@@ -194,6 +194,70 @@ namespace Exception
                 : RaytracingException("OBJECT", "No intersection found.", std::move(secondaryMessage)){};
         };
     } // namespace Object
+
+    /////////////////////////////////////////////////////////////////////
+    /// Loader
+    /////////////////////////////////////////////////////////////////////
+
+    namespace Loader
+    {
+        /**
+         * @brief Used when a file to load can't be opened.
+         */
+        class CantOpenFile : public RaytracingException
+        {
+        public:
+            explicit CantOpenFile(std::string secondaryMessage = "")
+                : RaytracingException("LOADER", "Can't open the file.", std::move(secondaryMessage)){};
+        };
+
+        /**
+         * @brief Used when a file to save can't be written.
+         */
+        class CantWriteFile : public RaytracingException
+        {
+        public:
+            explicit CantWriteFile(std::string secondaryMessage = "")
+                : RaytracingException("LOADER", "Can't write the file.", std::move(secondaryMessage)){};
+        };
+
+        /**
+         * @brief Used when a file to load is malformed.
+         */
+        class ParseError : public RaytracingException
+        {
+        public:
+            explicit ParseError(std::string secondaryMessage = "")
+                : RaytracingException("LOADER", "Can't parse the file.", std::move(secondaryMessage)){};
+        };
+
+        /**
+         * @brief Used when an image is saved in a format which isn't supported.
+         */
+        class UnsupportedFormat : public RaytracingException
+        {
+        public:
+            explicit UnsupportedFormat(std::string secondaryMessage = "")
+                : RaytracingException("LOADER", "Unsupported image format.", std::move(secondaryMessage)){};
+        };
+    } // namespace Loader
+
+    /////////////////////////////////////////////////////////////////////
+    /// Sampler
+    /////////////////////////////////////////////////////////////////////
+
+    namespace Sampler
+    {
+        /**
+         * @brief Used when a sampler is created without any sample.
+         */
+        class NoSample : public RaytracingException
+        {
+        public:
+            explicit NoSample(std::string secondaryMessage = "")
+                : RaytracingException("SAMPLER", "A pixel needs at least one sample.", std::move(secondaryMessage)){};
+        };
+    } // namespace Sampler
 } // namespace Exception
 
 #endif //H_RAYTRACING_EXCEPTIONS_H
@@ -0,0 +1,69 @@
+#include "Framebuffer.h"
+
+Framebuffer::Framebuffer(std::size_t width, std::size_t height)
+    : m_width(width),
+      m_height(height),
+      m_pixels(width * height)
+{
+}
+
+std::size_t Framebuffer::width() const
+{
+    return m_width;
+}
+
+std::size_t Framebuffer::height() const
+{
+    return m_height;
+}
+
+const Radiance& Framebuffer::getPixel(std::size_t x, std::size_t y) const
+{
+    return m_pixels[y * m_width + x];
+}
+
+void Framebuffer::setPixel(std::size_t x, std::size_t y, const Radiance& radiance)
+{
+    m_pixels[y * m_width + x] = radiance;
+}
+
+Radiance* Framebuffer::getRow(std::size_t y)
+{
+    return m_pixels.data() + y * m_width;
+}
+
+std::vector<std::uint8_t> Framebuffer::toRGB() const
+{
+    std::vector<std::uint8_t> res;
+    res.reserve(m_pixels.size() * 3);
+
+    for (const auto& pixel : m_pixels)
+    {
+        Color color = pixel.toColor();
+        res.push_back(color.red());
+        res.push_back(color.green());
+        res.push_back(color.blue());
+    }
+
+    return res;
+}
+
+#ifdef SFML_VIEWER
+sf::Image Framebuffer::toImage() const
+{
+    sf::Image image;
+    image.create(static_cast<unsigned int>(m_width), static_cast<unsigned int>(m_height));
+
+    for (std::size_t y = 0; y < m_height; y++)
+    {
+        for (std::size_t x = 0; x < m_width; x++)
+        {
+            image.setPixel(static_cast<unsigned int>(x),
+                           static_cast<unsigned int>(y),
+                           getPixel(x, y).toColor().toSFMLColor());
+        }
+    }
+
+    return image;
+}
+#endif
@@ -0,0 +1,86 @@
+#ifndef H_RAYTRACING_FRAMEBUFFER_H
+#define H_RAYTRACING_FRAMEBUFFER_H
+
+#include "Config.h"
+#include "Radiance.h"
+
+#ifdef SFML_VIEWER
+#include <SFML/Graphics/Image.hpp>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Framebuffer
+ * @brief Image of radiances, filled by the render.
+ *
+ * The pixels are stored row by row. The 8 bits image is only made at the end, with toRGB() (or toImage() for SFML).
+ *
+ * @see Radiance
+ */
+class Framebuffer
+{
+public:
+    /**
+     * @brief Create a black framebuffer.
+     *
+     * @param width  The width in pixels.
+     * @param height The height in pixels.
+     */
+    Framebuffer(std::size_t width, std::size_t height);
+
+    std::size_t width() const;
+    std::size_t height() const;
+
+    /**
+     * @brief Get a pixel.
+     *
+     * @param x The column.
+     * @param y The row.
+     *
+     * @return Returns the radiance of the pixel.
+     */
+    const Radiance& getPixel(std::size_t x, std::size_t y) const;
+
+    /**
+     * @brief Set a pixel.
+     *
+     * @param x        The column.
+     * @param y        The row.
+     * @param radiance The radiance of the pixel.
+     */
+    void setPixel(std::size_t x, std::size_t y, const Radiance& radiance);
+
+    /**
+     * @brief Get a row of pixels.
+     *
+     * @param y The row.
+     *
+     * @return Returns the first pixel of the row (the others follow).
+     */
+    Radiance* getRow(std::size_t y);
+
+    /**
+     * @brief Quantize the framebuffer to 8 bits RGB.
+     *
+     * @return Returns the red, green and blue channels of each pixel, row by row.
+     */
+    std::vector<std::uint8_t> toRGB() const;
+
+#ifdef SFML_VIEWER
+    /**
+     * @brief Quantize the framebuffer to an 8 bits image.
+     *
+     * @return Returns the image.
+     */
+    sf::Image toImage() const;
+#endif
+
+private:
+    std::size_t m_width;
+    std::size_t m_height;
+    std::vector<Radiance> m_pixels;
+};
+
+#endif //H_RAYTRACING_FRAMEBUFFER_H
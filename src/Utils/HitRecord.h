@@ -0,0 +1,45 @@
+#ifndef H_RAYTRACING_HITRECORD_H
+#define H_RAYTRACING_HITRECORD_H
+
+#include "Vector3.h"
+
+#include <cstddef>
+
+/**
+ * @struct HitRecord
+ * @brief Everything known about an intersection between a ray and an object.
+ *
+ * Filled by the intersection routines so that the shading never has to search the hit primitive again.
+ *
+ * @see Object, Ray
+ */
+struct HitRecord
+{
+    /**
+     * The ray parameter of the hit (point = origin + t * direction).
+     */
+    double t = 0.0;
+
+    /**
+     * The intersection point.
+     */
+    Vector3 point;
+
+    /**
+     * The geometric normal at the intersection point (not normalized).
+     */
+    Vector3 normal;
+
+    /**
+     * The index of the hit primitive inside the object (the triangle of a model, 0 otherwise).
+     */
+    std::size_t primitive = 0;
+
+    /**
+     * The barycentric coordinates of the hit in a triangle (point = (1 - u - v) * A + u * B + v * C).
+     */
+    double u = 0.0;
+    double v = 0.0;
+};
+
+#endif //H_RAYTRACING_HITRECORD_H
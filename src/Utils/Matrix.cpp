@@ -822,7 +822,7 @@ bool Matrix::areApproximatelyEqual(const Matrix& a, const Matrix& b, double prec
         {
             if (precision != 0)
             {
-                if (!areDoubleApproximatelyEqual(a.value(row, column), b.value(row, column), precision))
+                if (!areDoubleApproximatelyEqual(a.uncheckedValue(row, column), b.uncheckedValue(row, column), precision))
                     return false;
             }
             else
@@ -105,6 +105,22 @@ public:
         if (row >= m_rowCount || column >= m_columnCount)
             throw Exception::Matrix::WrongCoordinates("Can't get value.");
 
+        return m_matrix[m_columnCount * row + column];
+    }
+
+    /**
+     * @brief Get the value of one item in the matrix, without checking the coordinates in release.
+     *
+     * For the hot paths which already checked the size of the matrix. The coordinates are only checked in debug
+     * (without NDEBUG), see matrix().
+     *
+     * @param row    The line's location of our element.
+     * @param column The column's location of our element.
+     *
+     * @return Returns the value of the element at the given line and column.
+     */
+    constexpr double uncheckedValue(std::size_t row, std::size_t column) const
+    {
         return matrix(row, column);
     }
 
@@ -544,6 +560,81 @@ public:
      */
     static Matrix vectProduct(const Matrix& a, const Matrix& b);
 
+    /////////////////////////////////////////////////////////////////////
+    /// Fixed-dimension versions (Vector3), defined inline in Vector3.h
+    /////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Get the norm of a 3D vector.
+     *
+     * @param a The 3D vector.
+     *
+     * @return Returns the norm of the vector.
+     */
+    static double getNorm(const Vector3& a);
+
+    /**
+     * @brief Normalize a 3D vector.
+     *
+     * @param a The 3D vector.
+     *
+     * @return Returns the normalized vector of a.
+     */
+    static Vector3 normalize(const Vector3& a);
+
+    /**
+     * @brief Get the scalar product of 2 Vec3.
+     *
+     * @param a The first vec3.
+     * @param b The second vec3.
+     *
+     * @return Returns the scalar production of the 2 Vec3.
+     */
+    static double dot(const Vector3& a, const Vector3& b);
+
+    /**
+     * @brief Reflection implementation.
+     *
+     * @param directionPrimary   The direction of the primary ray.
+     * @param intersectionNormal The intersection normal.
+     *
+     * @return Returns the reflected ray direction.
+     */
+    static Vector3 reflection(const Vector3& directionPrimary, const Vector3& intersectionNormal);
+
+    /**
+     * @brief Refraction implementation.
+     *
+     * @param directionPrimary   The direction of the primary ray.
+     * @param intersectionNormal The intersection normal.
+     * @param n1                 The refraction value of the first material/environment.
+     * @param n2                 The refraction value of the second material/environment.
+     *
+     * @return Returns the refracted ray direction.
+     */
+    static Vector3 refraction(const Vector3& directionPrimary, const Vector3& intersectionNormal, double n1, double n2);
+
+    /**
+     * @brief Test if two 3D vectors are approximately equal.
+     *
+     * @param a         The first vector to compare.
+     * @param b         The second vector to compare.
+     * @param precision The precision of the comparison, a ~= b +- precision.
+     *
+     * @return Returns true if a and b are approximately equal.
+     */
+    static bool areApproximatelyEqual(const Vector3& a, const Vector3& b, double precision = 0.01);
+
+    /**
+     * @brief Get the vector product of 2 Vec3.
+     *
+     * @param a The first Vec3
+     * @param b The second Vec3.
+     *
+     * @return Returns vector product of the 2 Vec3, a^b.
+     */
+    static Vector3 vectProduct(const Vector3& a, const Vector3& b);
+
 protected:
     /**
      * @brief Allocate the matrix.
@@ -594,14 +685,19 @@ protected:
      * @param column The column index to the element.
      *
      * @return Returns a reference on the element.
+     *
+     * The access is checked in debug only: release builds (NDEBUG) compile it to a plain load, the sizes being
+     * already validated by the operations themselves.
      */
     constexpr double& matrix(std::size_t row, std::size_t column) const
     {
+#ifndef NDEBUG
         if (m_matrix == nullptr)
             throw Exception::Matrix::NotInitialized();
 
         if (row >= m_rowCount || column >= m_columnCount)
             throw Exception::Matrix::WrongCoordinates("Can't get value.");
+#endif
 
         return m_matrix[m_columnCount * row + column];
     }
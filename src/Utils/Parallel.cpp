@@ -0,0 +1,193 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+std::size_t resolveThreadCount(std::size_t threadCount)
+{
+    if (threadCount != 0)
+        return threadCount;
+
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+void parallelFor(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)>& function)
+{
+    threadCount = std::min(resolveThreadCount(threadCount), count);
+
+    if (threadCount <= 1)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            function(i);
+
+        return;
+    }
+
+    std::atomic<std::size_t> next = 0;
+
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < count; i = next++)
+        {
+            try
+            {
+                function(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception)
+                    exception = std::current_exception();
+
+                // Skip the remaining indexes
+                next = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; i++)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+namespace
+{
+    /**
+     * @brief Deque of indexes, popped by its owner thread from the front and stolen by the others from the back.
+     */
+    class WorkStealingDeque
+    {
+    public:
+        void push(std::size_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_indexes.push_back(index);
+        }
+
+        std::optional<std::size_t> pop()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_indexes.empty())
+                return std::nullopt;
+
+            std::size_t index = m_indexes.front();
+            m_indexes.pop_front();
+
+            return index;
+        }
+
+        std::optional<std::size_t> steal()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_indexes.empty())
+                return std::nullopt;
+
+            std::size_t index = m_indexes.back();
+            m_indexes.pop_back();
+
+            return index;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_indexes.clear();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::deque<std::size_t> m_indexes;
+    };
+} // namespace
+
+void parallelForWorkStealing(std::size_t count,
+                             std::size_t threadCount,
+                             const std::function<void(std::size_t index, std::size_t thread)>& function)
+{
+    threadCount = std::min(resolveThreadCount(threadCount), count);
+
+    if (threadCount <= 1)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            function(i, 0);
+
+        return;
+    }
+
+    // Contiguous ranges first, for the locality
+    std::vector<WorkStealingDeque> deques(threadCount);
+    for (std::size_t thread = 0; thread < threadCount; thread++)
+    {
+        for (std::size_t i = thread * count / threadCount; i < (thread + 1) * count / threadCount; i++)
+            deques[thread].push(i);
+    }
+
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto next = [&](std::size_t thread) -> std::optional<std::size_t> {
+        auto index = deques[thread].pop();
+        if (index.has_value())
+            return index;
+
+        // No index is added once started: if all the deques are empty, the work is done
+        for (std::size_t i = 1; i < threadCount; i++)
+        {
+            index = deques[(thread + i) % threadCount].steal();
+            if (index.has_value())
+                return index;
+        }
+
+        return std::nullopt;
+    };
+
+    auto worker = [&](std::size_t thread) {
+        for (auto index = next(thread); index.has_value(); index = next(thread))
+        {
+            try
+            {
+                function(index.value(), thread);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception)
+                    exception = std::current_exception();
+
+                // Skip the remaining indexes
+                for (auto& deque : deques)
+                    deque.clear();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; i++)
+        threads.emplace_back(worker, i);
+
+    worker(0);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
@@ -0,0 +1,48 @@
+#ifndef H_RAYTRACING_PARALLEL_H
+#define H_RAYTRACING_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Get the number of threads to use for a requested count.
+ *
+ * @param threadCount The requested number of threads (0 for all the hardware threads).
+ *
+ * @return Returns the number of threads to use (at least 1).
+ */
+std::size_t resolveThreadCount(std::size_t threadCount);
+
+/**
+ * @brief Call a function for every index of [0, count) on several threads.
+ *
+ * The indexes are distributed dynamically: each thread takes the next free index when it is done with the previous
+ * one, so that expensive and cheap indexes are balanced. The calling thread takes part in the work. If a call throws,
+ * the remaining indexes are skipped and the first exception is rethrown once all the threads are done.
+ *
+ * @param count       The number of indexes.
+ * @param threadCount The number of threads (0 for all the hardware threads).
+ * @param function    The function to call with each index.
+ */
+void parallelFor(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)>& function);
+
+/**
+ * @brief Call a function for every index of [0, count) on several threads, with work stealing.
+ *
+ * Each thread owns a deque, initially filled with a contiguous range of indexes, and takes its indexes from the
+ * front. A thread whose deque is empty steals indexes from the back of the other deques, so the threads stay busy
+ * when the cost of the indexes is uneven. The thread index given to the function allows to use thread-private
+ * storage. The exceptions are handled like in parallelFor.
+ *
+ * @param count       The number of indexes.
+ * @param threadCount The number of threads (0 for all the hardware threads).
+ * @param function    The function to call with each index and the index of the calling thread (in
+ *                    [0, resolveThreadCount(threadCount))).
+ *
+ * @see parallelFor
+ */
+void parallelForWorkStealing(std::size_t count,
+                             std::size_t threadCount,
+                             const std::function<void(std::size_t index, std::size_t thread)>& function);
+
+#endif //H_RAYTRACING_PARALLEL_H
@@ -0,0 +1,133 @@
+#ifndef H_RAYTRACING_RADIANCE_H
+#define H_RAYTRACING_RADIANCE_H
+
+#include "Color.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @struct Radiance
+ * @brief Linear RGB value used for the shading computations.
+ *
+ * Unlike Color, the channels are floats without any bound: nothing is lost between the computation steps and there
+ * is no clamp in the arithmetic. A channel of 1 corresponds to the 255 of a Color, the conversion to 8 bits happens
+ * only once the image is done.
+ *
+ * @see Color, Framebuffer
+ */
+struct Radiance
+{
+    /**
+     * @brief Create a black radiance.
+     */
+    constexpr Radiance() = default;
+
+    /**
+     * @brief Create a radiance.
+     *
+     * @param red   The red channel value.
+     * @param green The green channel value.
+     * @param blue  The blue channel value.
+     */
+    constexpr Radiance(float red, float green, float blue) : m_red(red), m_green(green), m_blue(blue)
+    {
+    }
+
+    /**
+     * @brief Create a radiance from a color (255 becomes 1).
+     *
+     * @param color The color.
+     */
+    explicit Radiance(const Color& color)
+        : m_red(static_cast<float>(color.red()) / 255.0f),
+          m_green(static_cast<float>(color.green()) / 255.0f),
+          m_blue(static_cast<float>(color.blue()) / 255.0f)
+    {
+    }
+
+    constexpr float red() const
+    {
+        return m_red;
+    }
+
+    constexpr float green() const
+    {
+        return m_green;
+    }
+
+    constexpr float blue() const
+    {
+        return m_blue;
+    }
+
+    /**
+     * @brief Quantize to an 8 bits color (clamped to [0;1], then rounded).
+     *
+     * @return Returns the color.
+     */
+    Color toColor() const
+    {
+        return Color(quantize(m_red), quantize(m_green), quantize(m_blue));
+    }
+
+    constexpr Radiance operator+(const Radiance& radiance) const
+    {
+        return Radiance(m_red + radiance.m_red, m_green + radiance.m_green, m_blue + radiance.m_blue);
+    }
+
+    constexpr Radiance& operator+=(const Radiance& radiance)
+    {
+        m_red += radiance.m_red;
+        m_green += radiance.m_green;
+        m_blue += radiance.m_blue;
+
+        return *this;
+    }
+
+    constexpr Radiance operator*(const Radiance& radiance) const
+    {
+        return Radiance(m_red * radiance.m_red, m_green * radiance.m_green, m_blue * radiance.m_blue);
+    }
+
+    constexpr Radiance operator*(double value) const
+    {
+        auto factor = static_cast<float>(value);
+
+        return Radiance(m_red * factor, m_green * factor, m_blue * factor);
+    }
+
+    constexpr Radiance& operator*=(double value)
+    {
+        auto factor = static_cast<float>(value);
+
+        m_red *= factor;
+        m_green *= factor;
+        m_blue *= factor;
+
+        return *this;
+    }
+
+    constexpr bool operator==(const Radiance& radiance) const
+    {
+        return m_red == radiance.m_red && m_green == radiance.m_green && m_blue == radiance.m_blue;
+    }
+
+    constexpr bool operator!=(const Radiance& radiance) const
+    {
+        return !(*this == radiance);
+    }
+
+private:
+    static std::uint8_t quantize(float channel)
+    {
+        return static_cast<std::uint8_t>(std::lround(std::clamp(channel, 0.0f, 1.0f) * 255.0f));
+    }
+
+    float m_red = 0.0f;
+    float m_green = 0.0f;
+    float m_blue = 0.0f;
+};
+
+#endif //H_RAYTRACING_RADIANCE_H
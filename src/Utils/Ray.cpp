@@ -2,10 +2,12 @@
 
 #include <utility>
 
-Ray::Ray(Vector3 origin, Vector3 direction, RayType type)
+Ray::Ray(Vector3 origin, Vector3 direction, RayType type, double tMin, double tMax)
     : m_type(type),
       m_direction(std::move(direction)),
-      m_origin(std::move(origin))
+      m_origin(std::move(origin)),
+      m_tMin(tMin),
+      m_tMax(tMax)
 {
 }
 
@@ -39,6 +41,36 @@ void Ray::setOrigin(const Vector3& origin)
     m_origin = origin;
 }
 
+double Ray::getParameter(const Vector3& point) const
+{
+    return Matrix::dot(point - m_origin, m_direction) / Matrix::dot(m_direction, m_direction);
+}
+
+double Ray::getTMin() const
+{
+    return m_tMin;
+}
+
+void Ray::setTMin(double tMin)
+{
+    m_tMin = tMin;
+}
+
+double Ray::getTMax() const
+{
+    return m_tMax;
+}
+
+void Ray::setTMax(double tMax)
+{
+    m_tMax = tMax;
+}
+
+bool Ray::isInInterval(double t) const
+{
+    return t >= m_tMin && t <= m_tMax;
+}
+
 bool Ray::operator==(const Ray& ray) const
 {
     return !(!Matrix::areApproximatelyEqual(ray.getOrigin(), getOrigin()) ||
@@ -3,6 +3,8 @@
 
 #include "Vector3.h"
 
+#include <limits>
+
 /**
  * @enum RayType
  * @brief Store the type of a ray.
@@ -16,6 +18,9 @@ enum RayType
 /**
  * @class Ray
  * @brief Describe a ray object.
+ *
+ * The ray only considers the points of parameter t in [tMin, tMax] (point = origin + t * direction), this allows the
+ * intersection routines to skip everything farther than the closest hit found so far.
  */
 class Ray
 {
@@ -26,10 +31,16 @@ public:
      * @param origin    The origin point of the ray.
      * @param direction The direction of the ray.
      * @param type      The type of the ray.
+     * @param tMin      The minimum ray parameter of an intersection.
+     * @param tMax      The maximum ray parameter of an intersection.
      *
      * @see RayType
      */
-    Ray(Vector3 origin, Vector3 direction, RayType type);
+    Ray(Vector3 origin,
+        Vector3 direction,
+        RayType type,
+        double tMin = 0.0,
+        double tMax = std::numeric_limits<double>::infinity());
 
     /**
      * @brief Get the type of the ray.
@@ -77,6 +88,52 @@ public:
      */
     void setOrigin(const Vector3& origin);
 
+    /**
+     * @brief Get the ray parameter of a point of the ray.
+     *
+     * @param point A point on the ray.
+     *
+     * @return Returns t such as point = origin + t * direction.
+     */
+    double getParameter(const Vector3& point) const;
+
+    /**
+     * @brief Get the minimum ray parameter of an intersection.
+     *
+     * @return Returns tMin.
+     */
+    double getTMin() const;
+
+    /**
+     * @brief Set the minimum ray parameter of an intersection.
+     *
+     * @param tMin The new tMin.
+     */
+    void setTMin(double tMin);
+
+    /**
+     * @brief Get the maximum ray parameter of an intersection.
+     *
+     * @return Returns tMax.
+     */
+    double getTMax() const;
+
+    /**
+     * @brief Set the maximum ray parameter of an intersection (usually the closest hit found so far).
+     *
+     * @param tMax The new tMax.
+     */
+    void setTMax(double tMax);
+
+    /**
+     * @brief Check if a ray parameter is in the ray interval.
+     *
+     * @param t The ray parameter.
+     *
+     * @return Returns true if tMin <= t <= tMax.
+     */
+    bool isInInterval(double t) const;
+
     /////////////////////////////////////////////////////////////////////
     /// Operators
     /////////////////////////////////////////////////////////////////////
@@ -88,6 +145,8 @@ private:
     RayType m_type = PRIMARY;
     Vector3 m_direction;
     Vector3 m_origin;
+    double m_tMin = 0.0;
+    double m_tMax = std::numeric_limits<double>::infinity();
 };
 
 #endif //H_RAYTRACING_RAY_H
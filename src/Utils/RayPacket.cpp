@@ -0,0 +1,52 @@
+#include "RayPacket.h"
+
+std::size_t RayPacket::count(Mask mask)
+{
+    std::size_t res = 0;
+    for (; mask != 0; mask &= mask - 1)
+        res++;
+
+    return res;
+}
+
+std::size_t RayPacket::first(Mask mask)
+{
+    std::size_t res = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        res++;
+    }
+
+    return res;
+}
+
+void RayPacket::setRay(std::size_t lane, const Ray& ray)
+{
+    const Vector3& origin = ray.getOrigin();
+    const Vector3& direction = ray.getDirection();
+
+    originX[lane] = origin.x();
+    originY[lane] = origin.y();
+    originZ[lane] = origin.z();
+
+    directionX[lane] = direction.x();
+    directionY[lane] = direction.y();
+    directionZ[lane] = direction.z();
+
+    inverseDirectionX[lane] = 1.0 / direction.x();
+    inverseDirectionY[lane] = 1.0 / direction.y();
+    inverseDirectionZ[lane] = 1.0 / direction.z();
+
+    tMin[lane] = ray.getTMin();
+    tMax[lane] = ray.getTMax();
+}
+
+Ray RayPacket::getRay(std::size_t lane) const
+{
+    return Ray(Vector3(originX[lane], originY[lane], originZ[lane]),
+               Vector3(directionX[lane], directionY[lane], directionZ[lane]),
+               PRIMARY,
+               tMin[lane],
+               tMax[lane]);
+}
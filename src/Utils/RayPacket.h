@@ -0,0 +1,111 @@
+#ifndef H_RAYTRACING_RAYPACKET_H
+#define H_RAYTRACING_RAYPACKET_H
+
+#include "HitRecord.h"
+#include "Ray.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct RayPacket
+ * @brief Rays traced together, stored by coordinate (one array per coordinate, a lane per ray).
+ *
+ * The rays of a packet are meant to be coherent, like the primary rays of neighbouring pixels, so that they visit the
+ * same BVH nodes and primitives. The SIMD kernels (see Simd.h) compute every lane at once, the lanes outside of the
+ * mask they are given are computed but ignored.
+ *
+ * The intersection routines only keep the closest hit of each ray: when a ray hits a primitive before its tMax, tMax
+ * is lowered to the hit and the hit record of the lane is replaced.
+ *
+ * @see Ray, BVH::traverse, Object::getHits
+ */
+struct alignas(64) RayPacket
+{
+    /**
+     * Number of rays of a packet.
+     */
+    static constexpr std::size_t SIZE = 16;
+
+    /**
+     * A set of lanes, one bit per lane.
+     */
+    using Mask = std::uint32_t;
+
+    /**
+     * A value per lane.
+     */
+    using Lanes = std::array<double, SIZE>;
+
+    static_assert(SIZE < sizeof(Mask) * 8, "A mask needs a bit per lane");
+
+    /**
+     * @brief Get the mask of the first lanes.
+     *
+     * @param count The number of lanes.
+     *
+     * @return Returns the mask of the lanes [0, count).
+     */
+    static constexpr Mask firstLanes(std::size_t count)
+    {
+        return (Mask(1) << count) - 1;
+    }
+
+    /**
+     * @brief Get the number of lanes of a mask.
+     *
+     * @param mask The mask.
+     *
+     * @return Returns the number of set bits.
+     */
+    static std::size_t count(Mask mask);
+
+    /**
+     * @brief Get the first lane of a mask.
+     *
+     * @param mask The mask (not empty).
+     *
+     * @return Returns the index of the lowest set bit.
+     */
+    static std::size_t first(Mask mask);
+
+    /**
+     * @brief Set the ray of a lane.
+     *
+     * @param lane The lane.
+     * @param ray  The ray (its type isn't kept, the packets are made of primary rays).
+     */
+    void setRay(std::size_t lane, const Ray& ray);
+
+    /**
+     * @brief Get the ray of a lane.
+     *
+     * @param lane The lane.
+     *
+     * @return Returns the ray, with the current interval of the lane.
+     */
+    Ray getRay(std::size_t lane) const;
+
+    Lanes originX{}; /*!< Origin of the rays. */
+    Lanes originY{};
+    Lanes originZ{};
+
+    Lanes directionX{}; /*!< Direction of the rays. */
+    Lanes directionY{};
+    Lanes directionZ{};
+
+    Lanes inverseDirectionX{}; /*!< Inverse of the direction, for the box tests. */
+    Lanes inverseDirectionY{};
+    Lanes inverseDirectionZ{};
+
+    Lanes tMin{}; /*!< Interval of the rays, tMax is the closest hit so far. */
+    Lanes tMax{};
+
+    /**
+     * The closest hit of each ray (only meaningful for the lanes reported as hit).
+     */
+    std::array<HitRecord, SIZE> hits{};
+};
+
+#endif //H_RAYTRACING_RAYPACKET_H
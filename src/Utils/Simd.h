@@ -0,0 +1,18 @@
+#ifndef H_RAYTRACING_SIMD_H
+#define H_RAYTRACING_SIMD_H
+
+/**
+ * @brief Compile a function for several instruction sets, the best one for the CPU is chosen when the program starts.
+ *
+ * Used on the kernels written as loops over the lanes of a RayPacket (without dependency between the lanes), which
+ * the compiler vectorizes: a loop over 16 doubles is 2 instructions with AVX-512, 4 with AVX2 and 8 with SSE2 (the
+ * x86-64 baseline). Only with GCC on x86-64 Linux, where the dispatch is resolved by the loader, the kernels are
+ * compiled once for the target of the build elsewhere.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SIMD_CLONES
+#endif
+
+#endif //H_RAYTRACING_SIMD_H
@@ -0,0 +1,175 @@
+#include "Transform.h"
+
+#include "Exceptions.h"
+
+#include <cstddef>
+
+namespace
+{
+    constexpr Transform::Matrix4 IDENTITY = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    /**
+     * @brief Apply the linear part of an affine matrix.
+     */
+    Vector3 applyLinear(const Transform::Matrix4& m, const Vector3& v)
+    {
+        return Vector3(m[0] * v.x() + m[1] * v.y() + m[2] * v.z(),
+                       m[4] * v.x() + m[5] * v.y() + m[6] * v.z(),
+                       m[8] * v.x() + m[9] * v.y() + m[10] * v.z());
+    }
+
+    /**
+     * @brief Apply an affine matrix to a point.
+     */
+    Vector3 applyAffine(const Transform::Matrix4& m, const Vector3& p)
+    {
+        return applyLinear(m, p) + Vector3(m[3], m[7], m[11]);
+    }
+
+    /**
+     * @brief Invert an affine matrix: the inverse of the linear part (cofactors), then the inverse translation.
+     */
+    Transform::Matrix4 invertAffine(const Transform::Matrix4& m)
+    {
+        if (m[12] != 0 || m[13] != 0 || m[14] != 0 || m[15] != 1)
+            throw Exception::Matrix::NotInvertible("The transform is not affine.");
+
+        double c00 = m[5] * m[10] - m[6] * m[9];
+        double c01 = m[6] * m[8] - m[4] * m[10];
+        double c02 = m[4] * m[9] - m[5] * m[8];
+
+        double determinant = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        if (determinant == 0)
+            throw Exception::Matrix::NotInvertible("For the transform.");
+
+        double inverseDeterminant = 1.0 / determinant;
+
+        Transform::Matrix4 res = IDENTITY;
+        res[0] = c00 * inverseDeterminant;
+        res[1] = (m[2] * m[9] - m[1] * m[10]) * inverseDeterminant;
+        res[2] = (m[1] * m[6] - m[2] * m[5]) * inverseDeterminant;
+        res[4] = c01 * inverseDeterminant;
+        res[5] = (m[0] * m[10] - m[2] * m[8]) * inverseDeterminant;
+        res[6] = (m[2] * m[4] - m[0] * m[6]) * inverseDeterminant;
+        res[8] = c02 * inverseDeterminant;
+        res[9] = (m[1] * m[8] - m[0] * m[9]) * inverseDeterminant;
+        res[10] = (m[0] * m[5] - m[1] * m[4]) * inverseDeterminant;
+
+        Vector3 translation = applyLinear(res, Vector3(m[3], m[7], m[11])) * -1;
+        res[3] = translation.x();
+        res[7] = translation.y();
+        res[11] = translation.z();
+
+        return res;
+    }
+} // namespace
+
+Transform::Transform() : m_matrix(IDENTITY), m_inverse(IDENTITY)
+{
+}
+
+Transform::Transform(const Matrix4& matrix) : m_matrix(matrix), m_inverse(invertAffine(matrix))
+{
+}
+
+Transform Transform::placement(const Vector3& coordinates, const Vector3& angle, double scale)
+{
+    // The columns are the transformed axes
+    std::array<Vector3, 3> axes = {Vector3(scale, 0, 0), Vector3(0, scale, 0), Vector3(0, 0, scale)};
+    for (auto& axis : axes)
+        axis.rotateX(angle.x()).rotateY(angle.y()).rotateZ(angle.z());
+
+    Matrix4 matrix = IDENTITY;
+    for (std::size_t column = 0; column < 3; column++)
+    {
+        matrix[column] = axes[column].x();
+        matrix[4 + column] = axes[column].y();
+        matrix[8 + column] = axes[column].z();
+    }
+
+    matrix[3] = coordinates.x();
+    matrix[7] = coordinates.y();
+    matrix[11] = coordinates.z();
+
+    return Transform(matrix);
+}
+
+const Transform::Matrix4& Transform::getMatrix() const
+{
+    return m_matrix;
+}
+
+const Transform::Matrix4& Transform::getInverse() const
+{
+    return m_inverse;
+}
+
+Vector3 Transform::transformPoint(const Vector3& point) const
+{
+    return applyAffine(m_matrix, point);
+}
+
+Vector3 Transform::transformVector(const Vector3& vector) const
+{
+    return applyLinear(m_matrix, vector);
+}
+
+Vector3 Transform::transformNormal(const Vector3& normal) const
+{
+    // Transpose of the inverse
+    const Matrix4& m = m_inverse;
+
+    return Vector3(m[0] * normal.x() + m[4] * normal.y() + m[8] * normal.z(),
+                   m[1] * normal.x() + m[5] * normal.y() + m[9] * normal.z(),
+                   m[2] * normal.x() + m[6] * normal.y() + m[10] * normal.z());
+}
+
+BoundingBox Transform::transformBox(const BoundingBox& box) const
+{
+    BoundingBox res;
+    for (std::size_t corner = 0; corner < 8; corner++)
+    {
+        res.extend(transformPoint(Vector3((corner & 1) != 0 ? box.max().x() : box.min().x(),
+                                          (corner & 2) != 0 ? box.max().y() : box.min().y(),
+                                          (corner & 4) != 0 ? box.max().z() : box.min().z())));
+    }
+
+    return res;
+}
+
+Vector3 Transform::inverseTransformPoint(const Vector3& point) const
+{
+    return applyAffine(m_inverse, point);
+}
+
+Vector3 Transform::inverseTransformVector(const Vector3& vector) const
+{
+    return applyLinear(m_inverse, vector);
+}
+
+Ray Transform::inverseTransformRay(const Ray& ray) const
+{
+    return Ray(inverseTransformPoint(ray.getOrigin()),
+               inverseTransformVector(ray.getDirection()),
+               ray.getType(),
+               ray.getTMin(),
+               ray.getTMax());
+}
+
+Transform Transform::operator*(const Transform& transform) const
+{
+    const Matrix4& a = m_matrix;
+    const Matrix4& b = transform.m_matrix;
+
+    Matrix4 res{};
+    for (std::size_t row = 0; row < 4; row++)
+    {
+        for (std::size_t column = 0; column < 4; column++)
+        {
+            for (std::size_t i = 0; i < 4; i++)
+                res[row * 4 + column] += a[row * 4 + i] * b[i * 4 + column];
+        }
+    }
+
+    return Transform(res);
+}
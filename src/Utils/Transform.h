@@ -0,0 +1,156 @@
+#ifndef H_RAYTRACING_TRANSFORM_H
+#define H_RAYTRACING_TRANSFORM_H
+
+#include "BoundingBox.h"
+#include "Ray.h"
+#include "Vector3.h"
+
+#include <array>
+
+/**
+ * @class Transform
+ * @brief Affine transform (4x4 matrix) stored with its inverse.
+ *
+ * Places an object space in the scene: the instances of a mesh (see Model) share the mesh, only their transform is
+ * different. The matrices are stored inline (row-major, the last row is always 0 0 0 1), so a transform is cheap to
+ * copy and to apply to every ray.
+ *
+ * @see Model, Mesh
+ */
+class Transform
+{
+public:
+    /**
+     * A 4x4 matrix, row-major.
+     */
+    using Matrix4 = std::array<double, 16>;
+
+    /**
+     * @brief Create the identity transform.
+     */
+    Transform();
+
+    /**
+     * @brief Create a transform from its matrix.
+     *
+     * @throw Exception::Matrix::NotInvertible if the matrix is not affine or not invertible.
+     *
+     * @param matrix The affine matrix (row-major), from the object space to the scene.
+     */
+    explicit Transform(const Matrix4& matrix);
+
+    /**
+     * @brief Create the transform of an object placed in the scene.
+     *
+     * The object is scaled, then rotated around the x, y then z axis, then translated.
+     *
+     * @param coordinates The translation.
+     * @param angle       The rotation angles (in radians) around each axis.
+     * @param scale       The uniform scale.
+     *
+     * @return Returns the transform.
+     */
+    static Transform placement(const Vector3& coordinates, const Vector3& angle, double scale);
+
+    /**
+     * @brief Get the matrix of the transform.
+     *
+     * @return Returns the matrix from the object space to the scene.
+     */
+    const Matrix4& getMatrix() const;
+
+    /**
+     * @brief Get the matrix of the inverse transform.
+     *
+     * @return Returns the matrix from the scene to the object space.
+     */
+    const Matrix4& getInverse() const;
+
+    /**
+     * @brief Transform a point from the object space to the scene.
+     *
+     * @param point The point.
+     *
+     * @return Returns the transformed point.
+     */
+    Vector3 transformPoint(const Vector3& point) const;
+
+    /**
+     * @brief Transform a direction from the object space to the scene (without translation).
+     *
+     * @param vector The direction.
+     *
+     * @return Returns the transformed direction.
+     */
+    Vector3 transformVector(const Vector3& vector) const;
+
+    /**
+     * @brief Transform a normal from the object space to the scene (with the inverse transpose matrix).
+     *
+     * @param normal The normal.
+     *
+     * @return Returns the transformed normal (not normalized).
+     */
+    Vector3 transformNormal(const Vector3& normal) const;
+
+    /**
+     * @brief Transform a bounding box from the object space to the scene.
+     *
+     * @param box The bounding box.
+     *
+     * @return Returns the bounding box of the transformed corners.
+     */
+    BoundingBox transformBox(const BoundingBox& box) const;
+
+    /**
+     * @brief Transform a point from the scene to the object space.
+     *
+     * @param point The point.
+     *
+     * @return Returns the transformed point.
+     */
+    Vector3 inverseTransformPoint(const Vector3& point) const;
+
+    /**
+     * @brief Transform a direction from the scene to the object space.
+     *
+     * @param vector The direction.
+     *
+     * @return Returns the transformed direction.
+     */
+    Vector3 inverseTransformVector(const Vector3& vector) const;
+
+    /**
+     * @brief Transform a ray from the scene to the object space.
+     *
+     * The direction isn't normalized, so that the ray parameter of a point is the same in both spaces (and the
+     * interval of the ray is kept).
+     *
+     * @param ray The ray.
+     *
+     * @return Returns the ray in the object space.
+     */
+    Ray inverseTransformRay(const Ray& ray) const;
+
+    /**
+     * @brief Compose two transforms.
+     *
+     * @param transform The transform applied first.
+     *
+     * @return Returns the transform applying transform then *this.
+     */
+    Transform operator*(const Transform& transform) const;
+
+private:
+    /**
+     * The matrix from the object space to the scene.
+     */
+    Matrix4 m_matrix;
+
+    /**
+     * The matrix from the scene to the object space.
+     */
+    Matrix4 m_inverse;
+};
+
+#endif //H_RAYTRACING_TRANSFORM_H
@@ -1,140 +1,165 @@
 #include "Vector3.h"
 
+#include "Math.h"
 #include "Utils.h"
 
 #include <cmath>
 
-Vector3::Vector3() : Matrix(1, 3)
-{
-}
-
-Vector3::Vector3(double x, double y, double z) : Matrix(1, 3)
-{
-    setX(x);
-    setY(y);
-    setZ(z);
-}
-
-Vector3::Vector3(const Vector3& vector) : Matrix(1, 3)
-{
-    Matrix::fill(vector);
-}
-
-Vector3::Vector3(Vector3&& vector) noexcept : Matrix(std::move(vector))
-{
-}
-
-Vector3::Vector3(const Matrix& matrix) : Matrix(1, 3)
+Vector3::Vector3(const Matrix& matrix)
 {
     if (matrix.getRowCount() == 1 && matrix.getColumnCount() == 3)
     {
-        *this = matrix;
+        m_x = matrix.uncheckedValue(0, 0);
+        m_y = matrix.uncheckedValue(0, 1);
+        m_z = matrix.uncheckedValue(0, 2);
     }
     else if (matrix.getRowCount() == 3 && matrix.getColumnCount() == 1)
     {
-        *this = Matrix::transposed(matrix);
+        m_x = matrix.uncheckedValue(0, 0);
+        m_y = matrix.uncheckedValue(1, 0);
+        m_z = matrix.uncheckedValue(2, 0);
     }
-    else if (matrix.getRowCount() != 1 || matrix.getColumnCount() != 3)
+    else
         throw Exception::Matrix::NotVector3("Can't initialize a Vector3 with this size (!= (1,3)).");
 }
 
-Vector3::Vector3(Matrix&& matrix) : Matrix(1, 3)
-{
-    if (matrix.getRowCount() == 1 && matrix.getColumnCount() == 3)
-    {
-        *this = std::move(matrix);
-    }
-    else if (matrix.getRowCount() == 3 || matrix.getColumnCount() == 1)
-    {
-        *this = Matrix::transposed(matrix);
-    }
-    else if (matrix.getRowCount() != 1 || matrix.getColumnCount() != 3)
-        throw Exception::Matrix::NotVector3("Can't initialize a Vector3 with this size (!= (1,3)).");
-}
-
-Vector3::Vector3(const std::initializer_list<double>& initializerList) : Matrix(1, 3)
+Vector3::Vector3(const std::initializer_list<double>& initializerList)
 {
     fill(initializerList);
 }
 
 void Vector3::setX(double value)
 {
-    matrix(0, 0) = value;
+    m_x = value;
 }
 
 void Vector3::setY(double value)
 {
-    matrix(0, 1) = value;
+    m_y = value;
 }
 
 void Vector3::setZ(double value)
 {
-    matrix(0, 2) = value;
+    m_z = value;
 }
 
 double Vector3::distance(const Vector3& vector) const
 {
-    double x = pow2(matrix(0, 0) - vector.matrix(0, 0));
-    double y = pow2(matrix(0, 1) - vector.matrix(0, 1));
-    double z = pow2(matrix(0, 2) - vector.matrix(0, 2));
+    double x = pow2(m_x - vector.m_x);
+    double y = pow2(m_y - vector.m_y);
+    double z = pow2(m_z - vector.m_z);
 
     return std::sqrt(x + y + z);
 }
 
-Vector3& Vector3::operator=(const Matrix& matrix)
+double Vector3::getNorm() const
+{
+    return std::sqrt(pow2(m_x) + pow2(m_y) + pow2(m_z));
+}
+
+Vector3& Vector3::normalize()
 {
-    if (!isVector3(matrix))
-        throw Exception::Matrix::NotVector3("The matrix can't be cast to a Vector3.");
+    double norm = getNorm();
 
-    allocate(1, 3);
-    Matrix::fill(matrix);
+    m_x /= norm;
+    m_y /= norm;
+    m_z /= norm;
 
     return *this;
 }
 
-Vector3& Vector3::operator=(const Vector3& vector)
+Vector3& Vector3::rotateX(double angle)
 {
-    if (this == &vector)
-        return *this;
+    double cos = std::cos(angle);
+    double sin = std::sin(angle);
 
-    allocate(1, 3);
+    double y = cos * m_y - sin * m_z;
+    double z = sin * m_y + cos * m_z;
 
-    setX(vector.x());
-    setY(vector.y());
-    setZ(vector.z());
+    m_y = y;
+    m_z = z;
 
     return *this;
 }
 
-Vector3& Vector3::operator=(Matrix&& matrix) noexcept(false)
+Vector3& Vector3::rotateY(double angle)
 {
-    if (!isVector3(matrix))
-        throw Exception::Matrix::NotVector3("Can't initialize a Vector3 with this size (!= (1,3)).");
+    double cos = std::cos(angle);
+    double sin = std::sin(angle);
 
-    MOVE(matrix);
+    double x = cos * m_x + sin * m_z;
+    double z = -sin * m_x + cos * m_z;
+
+    m_x = x;
+    m_z = z;
 
     return *this;
 }
 
-Vector3& Vector3::operator=(Vector3&& vector) noexcept
+Vector3& Vector3::rotateZ(double angle)
 {
-    if (this == &vector)
-        return *this;
+    double cos = std::cos(angle);
+    double sin = std::sin(angle);
+
+    double x = cos * m_x - sin * m_y;
+    double y = sin * m_x + cos * m_y;
 
-    MOVE(vector);
+    m_x = x;
+    m_y = y;
 
     return *this;
 }
 
+void Vector3::print(const std::string& name) const
+{
+    if (!name.empty())
+        std::cout << "Vector3 '" << name << "' print:" << std::endl;
+    else
+        std::cout << "Vector3 print:" << std::endl;
+
+    std::cout << "[ " << m_x << " " << m_y << " " << m_z << " ]" << std::endl;
+}
+
+Vector3::operator Matrix() const
+{
+    return Matrix(1, 3, {{m_x, m_y, m_z}});
+}
+
+Matrix Vector3::operator*(const Matrix& matrix) const
+{
+    return static_cast<Matrix>(*this) * matrix;
+}
+
+bool Vector3::operator==(const Vector3& vector) const
+{
+    return areDoubleEqual(m_x, vector.m_x) && areDoubleEqual(m_y, vector.m_y) && areDoubleEqual(m_z, vector.m_z);
+}
+
+bool Vector3::operator!=(const Vector3& vector) const
+{
+    return !(*this == vector);
+}
+
 void Vector3::fill(const std::initializer_list<double>& initializerList)
 {
     std::size_t column = 0;
     for (const auto& value : initializerList)
     {
-        if (column >= 3)
-            throw Exception::Vector3::WrongInitializerList();
+        switch (column)
+        {
+            case 0:
+                m_x = value;
+                break;
+            case 1:
+                m_y = value;
+                break;
+            case 2:
+                m_z = value;
+                break;
+            default:
+                throw Exception::Vector3::WrongInitializerList();
+        }
 
-        matrix(0, column) = value;
         column++;
     }
 }
@@ -142,4 +167,4 @@ void Vector3::fill(const std::initializer_list<double>& initializerList)
 bool isVector3(const Matrix& matrix)
 {
     return (matrix.getRowCount() == 1 && matrix.getColumnCount() == 3);
-}
\ No newline at end of file
+}
@@ -1,21 +1,28 @@
 #ifndef H_RAYTRACING_VECTOR3_H
 #define H_RAYTRACING_VECTOR3_H
 
+#include "Math.h"
 #include "Matrix.h"
 
+#include <algorithm>
+#include <cmath>
+
 /**
  * @class Vector3
  * @brief 3D Vector.
  *
+ * A value type with inline storage: it never allocates and is trivially copyable, so it can be freely passed around
+ * in the hot paths. It converts implicitly from and to a (1,3) Matrix for the general matrix calculations.
+ *
  * @see Matrix
  */
-class Vector3 : public Matrix
+class Vector3
 {
 public:
     /**
      * @brief Create an empty 3D vector.
      */
-    Vector3();
+    constexpr Vector3() = default;
 
     /**
      * @brief Create an empty 3D vector.
@@ -24,27 +31,16 @@ public:
      * @param y The y coordinate value.
      * @param z The z coordinate value.
      */
-    Vector3(double x, double y, double z);
-
-    /**
-     * @brief Create a 3D vector from another one.
-     *
-     * @param vector The vector to copy from.
-     */
-    Vector3(const Vector3& vector);
-
-    /**
-     * @brief Constructor by move.
-     */
-    Vector3(Vector3&& vector) noexcept;
+    constexpr Vector3(double x, double y, double z) : m_x(x), m_y(y), m_z(z)
+    {
+    }
 
     /**
-     * @brief Create a 3D vector from a matrix (1,3).
+     * @brief Create a 3D vector from a matrix (1,3) or (3,1).
      *
      * @param matrix The matrix to copy from.
      */
     Vector3(const Matrix& matrix); // NOLINT
-    Vector3(Matrix&& matrix);      // NOLINT
 
     /**
      * @brief Create a 3D vector from an initialized list.
@@ -62,7 +58,7 @@ public:
      */
     constexpr double x() const
     {
-        return value(0, 0);
+        return m_x;
     }
 
     /**
@@ -72,7 +68,7 @@ public:
      */
     constexpr double y() const
     {
-        return value(0, 1);
+        return m_y;
     }
 
     /**
@@ -82,7 +78,7 @@ public:
      */
     constexpr double z() const
     {
-        return value(0, 2);
+        return m_z;
     }
 
     /**
@@ -115,10 +111,114 @@ public:
      */
     double distance(const Vector3& vector) const;
 
-    Vector3& operator=(const Matrix& matrix);
-    Vector3& operator=(const Vector3& vector);
-    Vector3& operator=(Matrix&& matrix) noexcept(false);
-    Vector3& operator=(Vector3&& vector) noexcept;
+    /**
+     * @brief Get the norm of this vector.
+     *
+     * @return Returns the norm of the vector.
+     */
+    double getNorm() const;
+
+    /**
+     * @brief Normalize this vector.
+     *
+     * @return Returns *this.
+     *
+     * @see getNorm
+     */
+    Vector3& normalize();
+
+    /**
+     * @brief Rotate on x axis.
+     *
+     * @param angle The angle of the rotation.
+     *
+     * @return Returns *this.
+     */
+    Vector3& rotateX(double angle);
+
+    /**
+     * @brief Rotate on y axis.
+     *
+     * @param angle The angle of the rotation.
+     *
+     * @return Returns *this.
+     */
+    Vector3& rotateY(double angle);
+
+    /**
+     * @brief Rotate on z axis.
+     *
+     * @param angle The angle of the rotation.
+     *
+     * @return Returns *this.
+     */
+    Vector3& rotateZ(double angle);
+
+    /**
+     * @brief Print the vector.
+     *
+     * @param name The name of the vector (optional).
+     */
+    void print(const std::string& name = "") const;
+
+    /////////////////////////////////////////////////////////////////////
+    /// Operators
+    /////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Convert the vector to a (1,3) matrix.
+     */
+    operator Matrix() const; // NOLINT
+
+    constexpr Vector3& operator+=(const Vector3& vector)
+    {
+        m_x += vector.m_x;
+        m_y += vector.m_y;
+        m_z += vector.m_z;
+
+        return *this;
+    }
+
+    constexpr Vector3& operator-=(const Vector3& vector)
+    {
+        m_x -= vector.m_x;
+        m_y -= vector.m_y;
+        m_z -= vector.m_z;
+
+        return *this;
+    }
+
+    constexpr Vector3& operator*=(double scalar)
+    {
+        m_x *= scalar;
+        m_y *= scalar;
+        m_z *= scalar;
+
+        return *this;
+    }
+
+    constexpr Vector3 operator+(const Vector3& vector) const
+    {
+        return Vector3(m_x + vector.m_x, m_y + vector.m_y, m_z + vector.m_z);
+    }
+
+    constexpr Vector3 operator-(const Vector3& vector) const
+    {
+        return Vector3(m_x - vector.m_x, m_y - vector.m_y, m_z - vector.m_z);
+    }
+
+    constexpr Vector3 operator*(double scalar) const
+    {
+        return Vector3(m_x * scalar, m_y * scalar, m_z * scalar);
+    }
+
+    /**
+     * @brief Product of the vector, as a (1,3) matrix, with a matrix.
+     */
+    Matrix operator*(const Matrix& matrix) const;
+
+    bool operator==(const Vector3& vector) const;
+    bool operator!=(const Vector3& vector) const;
 
 protected:
     /**
@@ -127,6 +227,22 @@ protected:
      * @param initializerList The initializer list.
      */
     void fill(const std::initializer_list<double>& initializerList);
+
+private:
+    /**
+     * The x coordinate.
+     */
+    double m_x = 0.0;
+
+    /**
+     * The y coordinate.
+     */
+    double m_y = 0.0;
+
+    /**
+     * The z coordinate.
+     */
+    double m_z = 0.0;
 };
 
 /**
@@ -138,4 +254,76 @@ protected:
  */
 bool isVector3(const Matrix& matrix);
 
+/////////////////////////////////////////////////////////////////////
+/// Matrix fixed-dimension methods
+/////////////////////////////////////////////////////////////////////
+
+inline double Matrix::getNorm(const Vector3& a)
+{
+    return std::sqrt(a.x() * a.x() + a.y() * a.y() + a.z() * a.z());
+}
+
+inline Vector3 Matrix::normalize(const Vector3& a)
+{
+    double norm = Matrix::getNorm(a);
+
+    return Vector3(a.x() / norm, a.y() / norm, a.z() / norm);
+}
+
+inline double Matrix::dot(const Vector3& a, const Vector3& b)
+{
+    return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+}
+
+inline Vector3 Matrix::reflection(const Vector3& directionPrimary, const Vector3& intersectionNormal)
+{
+    Vector3 incident = Matrix::normalize(directionPrimary);
+    Vector3 normal = Matrix::normalize(intersectionNormal);
+
+    // I - 2 * (I.N)*N
+    return incident - normal * (Matrix::dot(incident, normal) * 2);
+}
+
+inline Vector3
+Matrix::refraction(const Vector3& directionPrimary, const Vector3& intersectionNormal, double n1, double n2)
+{
+    if (n1 == 0 || n2 == 0)
+        throw Exception::Math::DivisionByZero("Can't do the refraction.");
+
+    Vector3 incident = Matrix::normalize(directionPrimary);
+    Vector3 normal = Matrix::normalize(intersectionNormal);
+
+    double n = n1 / n2;
+
+    double temp = std::clamp(Matrix::dot(normal, incident), -1.0, 1.0);
+
+    double teta1 = std::acos(temp);
+    double teta2 = std::asin((n1 * std::sin(teta1)) / n2);
+
+    double cos1 = std::cos(teta1);
+    double cos2 = std::cos(teta2);
+
+    // Total internal reflection, keep the normalized direction: the matrix version returns its direction argument,
+    // but after normalizing it in place
+    if (teta1 > std::asin(n2 / n1) && n2 < n1)
+        return incident;
+
+    return Matrix::normalize(incident * n + normal * (n * cos1 + cos2));
+}
+
+inline bool Matrix::areApproximatelyEqual(const Vector3& a, const Vector3& b, double precision)
+{
+    if (precision == 0)
+        return a.x() == b.x() && a.y() == b.y() && a.z() == b.z();
+
+    return areDoubleApproximatelyEqual(a.x(), b.x(), precision) &&
+           areDoubleApproximatelyEqual(a.y(), b.y(), precision) &&
+           areDoubleApproximatelyEqual(a.z(), b.z(), precision);
+}
+
+inline Vector3 Matrix::vectProduct(const Vector3& a, const Vector3& b)
+{
+    return Vector3(a.y() * b.z() - a.z() * b.y(), -a.x() * b.z() + a.z() * b.x(), a.x() * b.y() - a.y() * b.x());
+}
+
 #endif //H_RAYTRACING_VECTOR3_H
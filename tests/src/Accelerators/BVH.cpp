@@ -0,0 +1,298 @@
+#include <Accelerators/BVH.h>
+#include <Objects/Plane.h>
+#include <Objects/Sphere.h>
+#include <Utils/Math.h>
+#include <doctest.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+TEST_CASE("Testing bounding box")
+{
+    BoundingBox box;
+    CHECK(box.isEmpty());
+    CHECK(box.surfaceArea() == 0);
+
+    box.extend(Vector3(0, 0, 0));
+    box.extend(Vector3(1, 2, 3));
+
+    CHECK(!box.isEmpty());
+    CHECK(box.largestAxis() == 2);
+    CHECK(box.center() == Vector3(0.5, 1, 1.5));
+    CHECK(areDoubleApproximatelyEqual(box.surfaceArea(), 22));
+
+    double tNear = 0;
+    Vector3 origin(0.5, 1, -5);
+    const double infinity = std::numeric_limits<double>::infinity();
+    Vector3 inverseDirection(infinity, infinity, 1);
+
+    CHECK(box.intersect(origin, inverseDirection, 100, tNear));
+    CHECK(areDoubleApproximatelyEqual(tNear, 5));
+    CHECK(!box.intersect(origin, inverseDirection, 4, tNear));
+    CHECK(!box.intersect(Vector3(5, 1, -5), inverseDirection, 100, tNear));
+
+    CHECK(Sphere(Materials::metal(), Colors::white(), Vector3(0, 0, 0), 1).isBounded());
+    CHECK(!Plane(Materials::metal(), Colors::white(), Vector3(0, 0, 0), Vector3(0, 1, 0)).isBounded());
+}
+
+TEST_CASE("Testing BVH")
+{
+    // Grid of spheres
+    std::vector<std::shared_ptr<Sphere>> spheres;
+    std::vector<BoundingBox> boxes;
+    for (int x = -5; x <= 5; x++)
+    {
+        for (int y = -5; y <= 5; y++)
+        {
+            spheres.push_back(std::make_shared<Sphere>(Materials::metal(),
+                                                       Colors::white(),
+                                                       Vector3(x * 3.0, y * 3.0, 10.0 + x + y),
+                                                       1.0));
+            boxes.push_back(spheres.back()->getBoundingBox());
+        }
+    }
+
+    BVH bvh;
+    CHECK(bvh.empty());
+
+    bvh.build(boxes);
+    CHECK(!bvh.empty());
+    CHECK(bvh.getBoundingBox().min() == Vector3(-16, -16, -1));
+    CHECK(bvh.getBoundingBox().max() == Vector3(16, 16, 21));
+
+    // The closest hit found with the hierarchy must be the one found by testing all the spheres
+    for (int x = -16; x <= 16; x++)
+    {
+        for (int y = -16; y <= 16; y++)
+        {
+            Ray ray(Vector3(0, 0, -10), Vector3(x * 0.1, y * 0.1, 1), PRIMARY);
+
+            double expected = std::numeric_limits<double>::infinity();
+            for (const auto& sphere : spheres)
+            {
+                auto intersection = sphere->getIntersection(ray);
+                if (intersection.has_value())
+                    expected = std::min(expected, ray.getParameter(intersection.value()));
+            }
+
+            double found = std::numeric_limits<double>::infinity();
+            bvh.traverse(ray, found, [&](std::size_t index, double& tMax) {
+                auto intersection = spheres[index]->getIntersection(ray);
+                if (intersection.has_value() && ray.getParameter(intersection.value()) < tMax)
+                    tMax = ray.getParameter(intersection.value());
+                found = tMax;
+                return false;
+            });
+
+            CHECK(found == expected);
+        }
+    }
+
+    bvh.clear();
+    CHECK(bvh.empty());
+}
+
+TEST_CASE("Testing BVH statistics")
+{
+    BVH bvh;
+
+    // Big enough to use the parallel builder
+    std::vector<BoundingBox> boxes;
+    for (int x = 0; x < 100; x++)
+    {
+        for (int y = 0; y < 100; y++)
+            boxes.emplace_back(Vector3(x, y, (x * y) % 7), Vector3(x + 0.5, y + 0.5, (x * y) % 7 + 0.5));
+    }
+
+    bvh.build(boxes);
+
+    const BVH::Statistics& statistics = bvh.getStatistics();
+    CHECK(statistics.primitiveCount == boxes.size());
+    CHECK(statistics.leafCount > 0);
+    CHECK(statistics.nodeCount == 2 * statistics.leafCount - 1);
+    CHECK(statistics.depth > 1);
+    CHECK(statistics.depth <= BVH::MAX_DEPTH);
+    CHECK(statistics.sahCost > 0.0);
+    CHECK_NOTHROW(bvh.printStatistics("grid"));
+
+    // Every box crossed by the ray must be reported, and no primitive twice
+    for (int x = 0; x < 100; x += 7)
+    {
+        Ray ray(Vector3(x + 0.25, 0.25, -10), Vector3(0, 0.5, 1), PRIMARY);
+        Vector3 inverseDirection(1.0 / ray.getDirection().x(),
+                                 1.0 / ray.getDirection().y(),
+                                 1.0 / ray.getDirection().z());
+
+        std::vector<int> reported(boxes.size(), 0);
+        double tMax = std::numeric_limits<double>::infinity();
+        bvh.traverse(ray, tMax, [&](std::size_t index, [[maybe_unused]] double& max) {
+            reported[index]++;
+            return false;
+        });
+
+        for (std::size_t i = 0; i < boxes.size(); i++)
+        {
+            double tNear = 0.0;
+            bool expected = boxes[i].intersect(ray.getOrigin(), inverseDirection, tMax, tNear);
+            CHECK(reported[i] <= 1);
+            if (expected)
+                CHECK(reported[i] == 1);
+        }
+    }
+
+    bvh.clear();
+    CHECK(bvh.getStatistics().nodeCount == 0);
+    CHECK(bvh.getWideNodes().empty());
+}
+
+TEST_CASE("Testing wide BVH")
+{
+    // Spheres along the z axis, every box is crossed by a ray along the axis
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < 300; i++)
+        boxes.emplace_back(Vector3(-1, -1, i * 3.0), Vector3(1, 1, i * 3.0 + 2));
+
+    BVH bvh;
+    bvh.build(boxes);
+
+    // Each primitive is in a single leaf, and the children are in the bounds of the root
+    const auto& wideNodes = bvh.getWideNodes();
+    REQUIRE(!wideNodes.empty());
+    CHECK(wideNodes.size() < bvh.getNodes().size());
+
+    std::vector<int> referenced(boxes.size(), 0);
+    for (const auto& node : wideNodes)
+    {
+        CHECK(node.childCount >= 2);
+        CHECK(node.childCount <= BVH::WIDE_NODE_SIZE);
+
+        for (std::size_t i = 0; i < node.childCount; i++)
+        {
+            CHECK(node.minZ[i] >= bvh.getBoundingBox().min().z());
+            CHECK(node.maxZ[i] <= bvh.getBoundingBox().max().z());
+
+            if (node.counts[i] == 0)
+                CHECK(node.offsets[i] < wideNodes.size());
+
+            for (std::uint32_t j = node.offsets[i]; node.counts[i] != 0 && j < node.offsets[i] + node.counts[i]; j++)
+                referenced[bvh.getIndices()[j]]++;
+        }
+    }
+
+    CHECK(std::count(referenced.begin(), referenced.end(), 1) == static_cast<std::ptrdiff_t>(boxes.size()));
+
+    // Nearest leaves first
+    Ray ray(Vector3(0, 0, -10), Vector3(0, 0, 1), PRIMARY);
+    std::vector<std::size_t> visited;
+    bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](std::size_t index, [[maybe_unused]] double& tMax) {
+        visited.push_back(index);
+        return false;
+    });
+
+    REQUIRE(visited.size() == boxes.size());
+    for (std::size_t i = BVH::MAX_LEAF_SIZE; i < visited.size(); i += BVH::MAX_LEAF_SIZE)
+        CHECK(visited[i - BVH::MAX_LEAF_SIZE] < visited[i] + BVH::MAX_LEAF_SIZE);
+
+    // Everything farther than the first hit is skipped
+    visited.clear();
+    bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](std::size_t index, double& tMax) {
+        visited.push_back(index);
+        tMax = std::min(tMax, 10.0 + static_cast<double>(index) * 3.0);
+        return false;
+    });
+
+    CHECK(visited.size() <= 2 * BVH::MAX_LEAF_SIZE);
+
+    // The traversal stops when asked
+    visited.clear();
+    bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](std::size_t index, [[maybe_unused]] double& tMax) {
+        visited.push_back(index);
+        return true;
+    });
+
+    CHECK(visited.size() == 1);
+
+    // A leaf at a time, the leaves are ranges of the indices
+    std::vector<int> leafReferenced(boxes.size(), 0);
+    bvh.traverseLeaves(ray,
+                       std::numeric_limits<double>::infinity(),
+                       [&](std::size_t begin, std::size_t count, [[maybe_unused]] double& tMax) {
+                           CHECK(count != 0);
+                           CHECK(count <= BVH::MAX_LEAF_SIZE);
+
+                           for (std::size_t i = begin; i < begin + count; i++)
+                               leafReferenced[bvh.getIndices()[i]]++;
+
+                           return false;
+                       });
+
+    CHECK(leafReferenced == referenced);
+
+    // Also built for a hierarchy given as is, and for a single leaf
+    BVH assigned;
+    assigned.assign(bvh.getNodes(), bvh.getIndices(), bvh.getStatistics());
+    CHECK(assigned.getWideNodes().size() == wideNodes.size());
+
+    BVH leaf;
+    leaf.build({boxes.front()});
+    REQUIRE(leaf.getWideNodes().size() == 1);
+    CHECK(leaf.getWideNodes().front().childCount == 1);
+
+    visited.clear();
+    leaf.traverse(ray, std::numeric_limits<double>::infinity(), [&](std::size_t index, [[maybe_unused]] double& tMax) {
+        visited.push_back(index);
+        return false;
+    });
+
+    CHECK(visited == std::vector<std::size_t>{0});
+}
+
+TEST_CASE("Testing BVH validity")
+{
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < 100; i++)
+        boxes.emplace_back(Vector3(i * 3.0, -1, -1), Vector3(i * 3.0 + 2, 1, 1));
+
+    BVH bvh;
+    bvh.build(boxes);
+
+    std::vector<BVH::Node> nodes(bvh.getNodes().begin(), bvh.getNodes().end());
+    std::vector<std::uint32_t> indices(bvh.getIndices().begin(), bvh.getIndices().end());
+    REQUIRE(nodes.front().count == 0);
+
+    CHECK(BVH::isValid(bvh.getNodes(), bvh.getIndices(), boxes.size()));
+    CHECK(!BVH::isValid(bvh.getNodes(), bvh.getIndices(), boxes.size() - 1));
+    CHECK(BVH::isValid(Buffer<BVH::Node>(), Buffer<std::uint32_t>(), 0));
+
+    auto isValid = [&](std::vector<BVH::Node> changedNodes) {
+        return BVH::isValid(Buffer<BVH::Node>(std::move(changedNodes)), Buffer<std::uint32_t>(indices), boxes.size());
+    };
+
+    // A child out of the nodes
+    std::vector<BVH::Node> changed = nodes;
+    changed.front().offset = static_cast<std::uint32_t>(nodes.size() - 1);
+    CHECK(!isValid(changed));
+
+    // A child shared by two parents, or a cycle to the root
+    changed = nodes;
+    changed.front().offset = 0;
+    CHECK(!isValid(changed));
+
+    // A leaf out of the indices
+    changed = nodes;
+    auto leaf = std::find_if(changed.begin(), changed.end(), [](const BVH::Node& node) { return node.count != 0; });
+    leaf->offset = static_cast<std::uint32_t>(indices.size());
+    CHECK(!isValid(changed));
+
+    // Deeper than the traversal stacks: a chain of interior nodes
+    std::vector<BVH::Node> chain(2 * BVH::MAX_DEPTH + 1);
+    for (std::size_t i = 0; i + 1 < chain.size(); i += 2)
+    {
+        chain[i].offset = static_cast<std::uint32_t>(i + 1);
+        chain[i + 1].count = 1;
+    }
+    chain.back().count = 1;
+    CHECK(!BVH::isValid(Buffer<BVH::Node>(std::move(chain)), Buffer<std::uint32_t>({0}), 1));
+}
@@ -0,0 +1,82 @@
+#include <Accelerators/SphereBatch.h>
+#include <Objects/Sphere.h>
+#include <Utils/Math.h>
+#include <doctest.h>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+TEST_CASE("Testing sphere batch")
+{
+    // Spheres around the z axis, with an empty slot every 3 slots
+    std::vector<std::optional<Sphere>> slots;
+    SphereBatch batch;
+    for (int i = 0; i < 20; i++)
+    {
+        if (i % 3 == 2)
+        {
+            slots.emplace_back();
+            batch.addEmpty();
+            continue;
+        }
+
+        Vector3 center((i % 4) * 0.5 - 0.75, (i % 5) * 0.4 - 0.8, 30.0 - i);
+        slots.emplace_back(Sphere(Materials::metal(), Colors::white(), center, 0.3 + (i % 3) * 0.4));
+        batch.add(center, 0.3 + (i % 3) * 0.4);
+    }
+
+    REQUIRE(batch.size() == slots.size());
+
+    // The closest hit of every range must be the one of the spheres one by one
+    std::size_t hitCount = 0;
+    for (int y = -6; y <= 6; y++)
+    {
+        for (int x = -6; x <= 6; x++)
+        {
+            Ray ray(Vector3(0.05, -0.03, 0), Vector3(x * 0.03, y * 0.03, 1), PRIMARY, 0, 26);
+
+            for (std::size_t begin = 0; begin < slots.size(); begin += 3)
+            {
+                for (std::size_t count : {1, 5, 8, 13})
+                {
+                    count = std::min(count, slots.size() - begin);
+
+                    std::optional<HitRecord> expected;
+                    std::size_t expectedSlot = 0;
+                    for (std::size_t i = begin; i < begin + count; i++)
+                    {
+                        auto hit = slots[i].has_value() ? slots[i]->getHit(ray) : std::nullopt;
+                        if (hit.has_value() && (!expected.has_value() || hit->t < expected->t))
+                        {
+                            expected = hit;
+                            expectedSlot = i;
+                        }
+                    }
+
+                    auto hit = batch.intersect(ray, begin, count);
+                    REQUIRE(hit.has_value() == expected.has_value());
+                    if (!hit.has_value())
+                        continue;
+
+                    hitCount++;
+                    CHECK(hit->slot == expectedSlot);
+                    CHECK(areDoubleApproximatelyEqual(hit->t, expected->t, 0.0000001));
+                }
+            }
+        }
+    }
+
+    CHECK(hitCount > 100);
+
+    // Inside a sphere, the hit is the way out
+    SphereBatch inside;
+    inside.add(Vector3(0, 0, 0), 2);
+    auto hit = inside.intersect(Ray(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY), 0, 1);
+    REQUIRE(hit.has_value());
+    CHECK(hit->t == 2);
+    CHECK(!inside.intersect(Ray(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY, 0, 1), 0, 1).has_value());
+
+    inside.clear();
+    CHECK(inside.size() == 0);
+}
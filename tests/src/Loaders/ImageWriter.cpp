@@ -0,0 +1,350 @@
+#include <Loaders/ImageWriter.h>
+#include <Utils/Exceptions.h>
+#include <doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::uint8_t> readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::uint32_t readBigEndian(const std::vector<std::uint8_t>& bytes, std::size_t offset)
+    {
+        std::uint32_t res = 0;
+        for (std::size_t i = 0; i < 4; i++)
+            res = (res << 8) | bytes[offset + i];
+
+        return res;
+    }
+
+    /**
+     * @brief Read the bits of a deflate stream, from the least significant bit of each byte.
+     */
+    class BitReader
+    {
+    public:
+        BitReader(const std::vector<std::uint8_t>& bytes, std::size_t offset) : m_bytes(bytes), m_offset(offset * 8)
+        {
+        }
+
+        std::uint32_t read(unsigned int count)
+        {
+            std::uint32_t res = 0;
+            for (unsigned int i = 0; i < count; i++, m_offset++)
+                res |= ((m_bytes.at(m_offset / 8) >> (m_offset % 8)) & 1u) << i;
+
+            return res;
+        }
+
+        std::uint32_t readCode(unsigned int length, std::uint32_t code = 0)
+        {
+            for (unsigned int i = 0; i < length; i++)
+                code = (code << 1) | read(1);
+
+            return code;
+        }
+
+        std::size_t getByteOffset() const
+        {
+            return (m_offset + 7) / 8;
+        }
+
+    private:
+        const std::vector<std::uint8_t>& m_bytes;
+        std::size_t m_offset;
+    };
+
+    /**
+     * @brief Decompress a deflate stream of stored or fixed Huffman blocks (what the PNG writer writes).
+     */
+    std::vector<std::uint8_t> inflate(BitReader& bits)
+    {
+        const std::vector<std::size_t> lengthBases = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        const std::vector<unsigned int> lengthExtraBits = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                                           2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+        std::vector<std::uint8_t> res;
+        bool final = false;
+        while (!final)
+        {
+            final = bits.read(1) == 1;
+            std::uint32_t type = bits.read(2);
+            REQUIRE(type == 1);
+
+            while (true)
+            {
+                // Fixed Huffman codes: 7 bits (256 to 279), 8 bits (0 to 143 and 280 to 287) or 9 bits (144 to 255)
+                std::uint32_t symbol = 0;
+                std::uint32_t code = bits.readCode(7);
+                if (code <= 0x17)
+                    symbol = 256 + code;
+                else
+                {
+                    code = bits.readCode(1, code);
+                    if (code >= 0x30 && code <= 0xBF)
+                        symbol = code - 0x30;
+                    else if (code >= 0xC0 && code <= 0xC7)
+                        symbol = 280 + code - 0xC0;
+                    else
+                        symbol = 144 + bits.readCode(1, code) - 0x190;
+                }
+
+                if (symbol < 256)
+                {
+                    res.push_back(static_cast<std::uint8_t>(symbol));
+                    continue;
+                }
+
+                if (symbol == 256)
+                    break;
+
+                REQUIRE(symbol - 257 < lengthBases.size());
+                std::size_t length = lengthBases[symbol - 257] + bits.read(lengthExtraBits[symbol - 257]);
+
+                std::uint32_t distanceCode = bits.readCode(5);
+                REQUIRE(distanceCode < 30);
+                std::size_t distance = 1;
+                unsigned int extraBits = distanceCode < 4 ? 0 : distanceCode / 2 - 1;
+                for (std::uint32_t i = 0; i < distanceCode; i++)
+                    distance += std::size_t(1) << (i < 4 ? 0 : i / 2 - 1);
+                distance += bits.read(extraBits);
+
+                REQUIRE(distance <= res.size());
+                for (std::size_t i = 0; i < length; i++)
+                    res.push_back(res[res.size() - distance]);
+            }
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Undo the PNG filters of the rows of RGB pixels.
+     */
+    std::vector<std::uint8_t> unfilterRows(const std::vector<std::uint8_t>& rows, std::size_t width, std::size_t height)
+    {
+        std::size_t rowSize = width * 3;
+        std::vector<std::uint8_t> res(rowSize * height);
+
+        for (std::size_t y = 0; y < height; y++)
+        {
+            std::uint8_t filter = rows[y * (rowSize + 1)];
+            REQUIRE(filter <= 4);
+
+            for (std::size_t i = 0; i < rowSize; i++)
+            {
+                int left = i >= 3 ? res[y * rowSize + i - 3] : 0;
+                int up = y > 0 ? res[(y - 1) * rowSize + i] : 0;
+                int upLeft = y > 0 && i >= 3 ? res[(y - 1) * rowSize + i - 3] : 0;
+
+                int prediction = 0;
+                if (filter == 1)
+                    prediction = left;
+                else if (filter == 2)
+                    prediction = up;
+                else if (filter == 3)
+                    prediction = (left + up) / 2;
+                else if (filter == 4)
+                {
+                    int estimate = left + up - upLeft;
+                    int distanceLeft = std::abs(estimate - left);
+                    int distanceUp = std::abs(estimate - up);
+                    int distanceUpLeft = std::abs(estimate - upLeft);
+
+                    if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft)
+                        prediction = left;
+                    else if (distanceUp <= distanceUpLeft)
+                        prediction = up;
+                    else
+                        prediction = upLeft;
+                }
+
+                res[y * rowSize + i] = static_cast<std::uint8_t>(rows[y * (rowSize + 1) + 1 + i] + prediction);
+            }
+        }
+
+        return res;
+    }
+
+    std::uint32_t adler32(const std::vector<std::uint8_t>& data)
+    {
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        for (std::uint8_t value : data)
+        {
+            a = (a + value) % 65521;
+            b = (b + a) % 65521;
+        }
+
+        return (b << 16) | a;
+    }
+
+    /**
+     * @brief A gradient, different on each channel.
+     */
+    Framebuffer makeGradient(std::size_t width, std::size_t height)
+    {
+        Framebuffer framebuffer(width, height);
+        for (std::size_t y = 0; y < height; y++)
+        {
+            for (std::size_t x = 0; x < width; x++)
+            {
+                framebuffer.setPixel(x,
+                                     y,
+                                     Radiance(static_cast<float>(x) / static_cast<float>(width),
+                                              static_cast<float>(y) / static_cast<float>(height),
+                                              0.5f));
+            }
+        }
+
+        return framebuffer;
+    }
+} // namespace
+
+TEST_CASE("Testing PPM writer")
+{
+    Framebuffer framebuffer = makeGradient(5, 3);
+    std::vector<std::uint8_t> pixels = framebuffer.toRGB();
+
+    ImageWriter::write("test_image.PPM", framebuffer);
+    std::vector<std::uint8_t> file = readFile("test_image.PPM");
+
+    std::string header = "P6\n5 3\n255\n";
+    REQUIRE(file.size() == header.size() + pixels.size());
+    CHECK(std::string(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(header.size())) == header);
+    CHECK(std::vector<std::uint8_t>(file.begin() + static_cast<std::ptrdiff_t>(header.size()), file.end()) == pixels);
+
+    std::remove("test_image.PPM");
+
+    CHECK_THROWS_AS(ImageWriter::write("missing/folder/test_image.ppm", framebuffer), Exception::Loader::CantWriteFile);
+}
+
+TEST_CASE("Testing PNG writer")
+{
+    // Bigger than the window of deflate (32768 bytes)
+    const std::size_t width = 200;
+    const std::size_t height = 120;
+
+    Framebuffer framebuffer = makeGradient(width, height);
+    std::vector<std::uint8_t> pixels = framebuffer.toRGB();
+
+    ImageWriter::writePNG("test_image.png", width, height, pixels);
+    std::vector<std::uint8_t> file = readFile("test_image.png");
+    std::remove("test_image.png");
+
+    const std::vector<std::uint8_t> signature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    REQUIRE(file.size() > signature.size());
+    CHECK(std::vector<std::uint8_t>(file.begin(), file.begin() + 8) == signature);
+
+    // Read the chunks
+    std::vector<std::string> types;
+    std::vector<std::uint8_t> header;
+    std::vector<std::uint8_t> data;
+    std::size_t offset = 8;
+    while (offset + 12 <= file.size())
+    {
+        std::size_t length = readBigEndian(file, offset);
+        std::string type(file.begin() + static_cast<std::ptrdiff_t>(offset + 4),
+                         file.begin() + static_cast<std::ptrdiff_t>(offset + 8));
+        REQUIRE(offset + 12 + length <= file.size());
+
+        auto begin = file.begin() + static_cast<std::ptrdiff_t>(offset + 8);
+        if (type == "IHDR")
+            header.assign(begin, begin + static_cast<std::ptrdiff_t>(length));
+        if (type == "IDAT")
+            data.insert(data.end(), begin, begin + static_cast<std::ptrdiff_t>(length));
+
+        types.push_back(type);
+        offset += 12 + length;
+    }
+
+    CHECK(offset == file.size());
+    CHECK(types == std::vector<std::string>{"IHDR", "IDAT", "IEND"});
+
+    // Known CRC of the empty IEND chunk
+    CHECK(readBigEndian(file, file.size() - 4) == 0xAE426082);
+
+    REQUIRE(header.size() == 13);
+    CHECK(readBigEndian(header, 0) == width);
+    CHECK(readBigEndian(header, 4) == height);
+    CHECK(header[8] == 8);
+    CHECK(header[9] == 2);
+
+    // Zlib header, then the compressed rows and the checksum
+    REQUIRE(data.size() > 6);
+    CHECK((data[0] * 256 + data[1]) % 31 == 0);
+    CHECK((data[0] & 0x0F) == 8);
+
+    BitReader bits(data, 2);
+    std::vector<std::uint8_t> rows = inflate(bits);
+    CHECK(bits.getByteOffset() + 4 == data.size());
+    CHECK(readBigEndian(data, data.size() - 4) == adler32(rows));
+
+    // The gradient is compressed
+    CHECK(data.size() < pixels.size() / 4);
+
+    REQUIRE(rows.size() == height * (width * 3 + 1));
+    CHECK(unfilterRows(rows, width, height) == pixels);
+
+    // Noise (few matches) and a plain image (long matches)
+    for (std::uint32_t seed : {0u, 1u})
+    {
+        std::vector<std::uint8_t> image(64 * 48 * 3, 200);
+        std::uint32_t random = 12345;
+        for (auto& value : image)
+        {
+            random = random * 1103515245u + 12345u;
+            value = seed == 0 ? static_cast<std::uint8_t>(random >> 24) : value;
+        }
+
+        ImageWriter::writePNG("test_image.png", 64, 48, image);
+        std::vector<std::uint8_t> imageFile = readFile("test_image.png");
+        std::remove("test_image.png");
+
+        // The IDAT chunk follows the signature and the IHDR chunk
+        std::size_t length = readBigEndian(imageFile, 33);
+        std::vector<std::uint8_t> imageData(imageFile.begin() + 41,
+                                            imageFile.begin() + 41 + static_cast<std::ptrdiff_t>(length));
+
+        BitReader imageBits(imageData, 2);
+        CHECK(unfilterRows(inflate(imageBits), 64, 48) == image);
+    }
+}
+
+TEST_CASE("Testing image formats")
+{
+    Framebuffer framebuffer(2, 2);
+
+    ImageWriter::write("test_image.png", framebuffer);
+    CHECK(readFile("test_image.png").size() > 8);
+    std::remove("test_image.png");
+
+    CHECK(ImageWriter::isSupported("image.PPM"));
+    CHECK(ImageWriter::isSupported("folder.png/image.png"));
+    CHECK(!ImageWriter::isSupported("image.gif"));
+    CHECK(!ImageWriter::isSupported("image"));
+    CHECK(!ImageWriter::isSupported("folder.png/image"));
+
+    // The other formats are written by SFML
+#ifdef SFML_VIEWER
+    CHECK(ImageWriter::isSupported("image.jpg"));
+#else
+    CHECK(!ImageWriter::isSupported("image.jpg"));
+    CHECK_THROWS_AS(ImageWriter::write("test_image.jpg", framebuffer), Exception::Loader::UnsupportedFormat);
+#endif
+
+    CHECK_THROWS_AS(ImageWriter::write("test_image.gif", framebuffer), Exception::Loader::UnsupportedFormat);
+    CHECK_THROWS_AS(ImageWriter::write("test_image", framebuffer), Exception::Loader::UnsupportedFormat);
+}
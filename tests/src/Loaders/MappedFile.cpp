@@ -0,0 +1,18 @@
+#include <Loaders/MappedFile.h>
+#include <Utils/Exceptions.h>
+#include <doctest.h>
+
+#include <fstream>
+#include <sstream>
+
+TEST_CASE("Testing mapped file")
+{
+    std::ifstream stream("res/Object/cube.obj", std::ios::binary);
+    std::stringstream content;
+    content << stream.rdbuf();
+
+    MappedFile file("res/Object/cube.obj");
+    CHECK(file.getContent() == content.str());
+
+    CHECK_THROWS_AS(MappedFile("res/Object/missing.obj"), Exception::Loader::CantOpenFile);
+}
@@ -0,0 +1,101 @@
+#include <Loaders/MeshCache.h>
+#include <Loaders/ObjParser.h>
+#include <doctest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+TEST_CASE("Testing mesh cache")
+{
+    // 64 bits FNV-1a reference values
+    CHECK(MeshCache::hash("") == 0xcbf29ce484222325ULL);
+    CHECK(MeshCache::hash("a") == 0xaf63dc4c8601ec8cULL);
+    CHECK(MeshCache::hash("foobar") == 0x85944171f73967e8ULL);
+
+    // Two triangles
+    std::vector<Vector3> positions = {Vector3(0, 0, 5), Vector3(4, 0, 5), Vector3(0, 4, 5), Vector3(4, 4, 6)};
+    std::vector<std::uint32_t> indexes = {0, 1, 2, 2, 1, 3};
+
+    std::vector<BoundingBox> boxes(2);
+    for (std::size_t i = 0; i < indexes.size(); i++)
+        boxes[i / 3].extend(positions[indexes[i]]);
+
+    MeshCache::Content content;
+    content.positions = Buffer<Vector3>(positions);
+    content.normals = Buffer<Vector3>({Vector3(0, 0, 1)});
+    content.indexes = Buffer<std::uint32_t>(indexes);
+    content.normalIndexes = Buffer<std::uint32_t>({0, 0});
+    content.bvh.build(boxes);
+
+    // The size and time of a 6 bytes source
+    MeshCache::Key key{6, 1000, MeshCache::hash("source")};
+    int hashCount = 0;
+    auto sourceHash = [&hashCount]() {
+        hashCount++;
+        return MeshCache::hash("source");
+    };
+    std::string path = MeshCache::getPath("mesh-cache-test.obj");
+
+    CHECK(!MeshCache::read(path, key, sourceHash).has_value());
+    CHECK(MeshCache::write(path, key, content));
+
+    auto cached = MeshCache::read(path, key, sourceHash);
+    CHECK(cached.has_value());
+    CHECK(std::vector<Vector3>(cached->positions.begin(), cached->positions.end()) == positions);
+    CHECK(std::vector<std::uint32_t>(cached->indexes.begin(), cached->indexes.end()) == indexes);
+    CHECK(cached->normals.size() == 1);
+    CHECK(cached->normalIndexes.size() == 2);
+    CHECK(cached->bvh.getNodes().size() == content.bvh.getNodes().size());
+    CHECK(cached->bvh.getStatistics().sahCost == content.bvh.getStatistics().sahCost);
+    CHECK(cached->bvh.getBoundingBox().max() == Vector3(4, 4, 6));
+
+    // The data stays valid after the copy of a buffer viewing the file
+    Buffer<Vector3> copy = cached->positions;
+    cached.reset();
+    CHECK(copy[3] == Vector3(4, 4, 6));
+
+    // An existing cache is replaced, without leaving the temporary file
+    CHECK(MeshCache::write(path, key, content));
+    CHECK(MeshCache::read(path, key, sourceHash).has_value());
+    for (const auto& entry : std::filesystem::directory_iterator("."))
+        CHECK(entry.path().filename().string().rfind(path + ".", 0) != 0);
+
+    // The source isn't hashed while its size and time match
+    CHECK(hashCount == 0);
+
+    // Only the time changed (same content)
+    MeshCache::Key touched = key;
+    touched.sourceTime = 2000;
+    CHECK(MeshCache::read(path, touched, sourceHash).has_value());
+    CHECK(hashCount == 1);
+
+    // The content changed, with the same size or not
+    CHECK(!MeshCache::read(path, touched, []() { return MeshCache::hash("change"); }).has_value());
+
+    MeshCache::Key resized = key;
+    resized.sourceSize = 7;
+    CHECK(!MeshCache::read(path, resized, sourceHash).has_value());
+    CHECK(hashCount == 1);
+
+    // A vertex or normal index out of the arrays (damaged file) is a cache miss, a missing normal is not
+    content.normalIndexes = Buffer<std::uint32_t>({0, ObjMesh::NO_INDEX});
+    CHECK(MeshCache::write(path, key, content));
+    CHECK(MeshCache::read(path, key, sourceHash).has_value());
+
+    content.normalIndexes = Buffer<std::uint32_t>({0, 1});
+    CHECK(MeshCache::write(path, key, content));
+    CHECK(!MeshCache::read(path, key, sourceHash).has_value());
+
+    content.normalIndexes = Buffer<std::uint32_t>({0, 0});
+    content.indexes = Buffer<std::uint32_t>({0, 1, 2, 2, 1, 4});
+    CHECK(MeshCache::write(path, key, content));
+    CHECK(!MeshCache::read(path, key, sourceHash).has_value());
+
+    // Truncated file
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "RTMESH";
+    CHECK(!MeshCache::read(path, key, sourceHash).has_value());
+
+    std::remove(path.c_str());
+}
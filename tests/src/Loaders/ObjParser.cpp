@@ -0,0 +1,128 @@
+#include <Loaders/ObjParser.h>
+#include <Utils/Exceptions.h>
+#include <doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+TEST_CASE("Testing OBJ parser")
+{
+    ObjMesh mesh = ObjParser::parse("# comment\n"
+                                    "o object\n"
+                                    "v 0 0 0\n"
+                                    "v 1.5 0 -2e-1\n"
+                                    "v\t+1 1 0 1.0\r\n"
+                                    "v 0 1 0\n"
+                                    "vt 0.5 0.25\n"
+                                    "vt 1\n"
+                                    "vn 0 0 1\n"
+                                    "vn 0 0 -1\n"
+                                    "s off\n"
+                                    "f 1 2 3\n"
+                                    "f 1/1 2/2 3/1\n"
+                                    "f 1//2 2//2 3//1\n"
+                                    "f 1/1/1 2/2/1 3/1/2 4/2/2\n"
+                                    "f -4/-2/-1 -3//-2 -1");
+
+    CHECK(mesh.positions.size() == 4);
+    CHECK(mesh.positions[1] == Vector3(1.5, 0, -0.2));
+    CHECK(mesh.positions[2] == Vector3(1, 1, 0));
+
+    CHECK(mesh.textureCoordinates.size() == 2);
+    CHECK(mesh.textureCoordinates[0][1] == 0.25);
+    CHECK(mesh.textureCoordinates[1][1] == 0.0);
+
+    CHECK(mesh.normals.size() == 2);
+    CHECK(mesh.normals[1] == Vector3(0, 0, -1));
+
+    // The quad is split in 2 triangles
+    CHECK(mesh.getTriangleCount() == 6);
+
+    const auto none = ObjMesh::NO_INDEX;
+
+    // v
+    CHECK(std::vector<std::uint32_t>(&mesh.positionIndexes[0], &mesh.positionIndexes[3]) ==
+          std::vector<std::uint32_t>{0, 1, 2});
+    CHECK(mesh.textureIndexes[0] == none);
+    CHECK(mesh.normalIndexes[0] == none);
+
+    // v/vt
+    CHECK(mesh.textureIndexes[4] == 1);
+    CHECK(mesh.normalIndexes[4] == none);
+
+    // v//vn
+    CHECK(mesh.textureIndexes[6] == none);
+    CHECK(mesh.normalIndexes[6] == 1);
+
+    // v/vt/vn, fan triangulation
+    CHECK(std::vector<std::uint32_t>(&mesh.positionIndexes[9], &mesh.positionIndexes[15]) ==
+          std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3});
+    CHECK(mesh.normalIndexes[14] == 1);
+
+    // Negative indexes
+    CHECK(std::vector<std::uint32_t>(&mesh.positionIndexes[15], &mesh.positionIndexes[18]) ==
+          std::vector<std::uint32_t>{0, 1, 3});
+    CHECK(mesh.textureIndexes[15] == 0);
+    CHECK(mesh.normalIndexes[15] == 1);
+    CHECK(mesh.normalIndexes[16] == 0);
+    CHECK(mesh.normalIndexes[17] == none);
+
+    // Errors
+    CHECK_THROWS_AS(ObjParser::parse("v 0 0 0\nv 1 0 0\nf 1 2\n"), Exception::Loader::ParseError);
+    CHECK_THROWS_AS(ObjParser::parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n"), Exception::Loader::ParseError);
+    CHECK_THROWS_AS(ObjParser::parse("v 0 0 0\nv 1 0 0\nf 1 2 -3\n"), Exception::Loader::ParseError);
+    CHECK_THROWS_AS(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 0 1 2\n"), Exception::Loader::ParseError);
+    CHECK_THROWS_AS(ObjParser::parse("v 0 zero 0\n"), Exception::Loader::ParseError);
+    CHECK_THROWS_AS(ObjParser::read("res/Object/missing.obj"), Exception::Loader::CantOpenFile);
+
+    // File
+    ObjMesh cube = ObjParser::read("res/Object/cube.obj");
+    CHECK(cube.positions.size() == 8);
+    CHECK(cube.normals.size() == 6);
+    CHECK(cube.getTriangleCount() == 12);
+}
+
+TEST_CASE("Testing OBJ parser chunks")
+{
+    // Big enough to be split in several chunks, with negative indexes across the chunk boundaries
+    std::string text;
+    for (int i = 0; i < 20000; i++)
+    {
+        text += "v " + std::to_string(i) + " " + std::to_string(i % 7) + " 0.5\n";
+        text += "vn 0 0 1\n";
+
+        if (i >= 2)
+            text += "f -3//-1 " + std::to_string(i) + "//" + std::to_string(i + 1) + " -1//-2 " +
+                    std::to_string(i - 1) + "\n";
+    }
+
+    CHECK(text.size() > 4 * ObjParser::MIN_CHUNK_SIZE);
+
+    ObjMesh serial = ObjParser::parse(text, 1);
+    ObjMesh parallel = ObjParser::parse(text, 4);
+
+    CHECK(serial.positions.size() == 20000);
+    CHECK(serial.getTriangleCount() == 2 * 19998);
+    CHECK(parallel.positions == serial.positions);
+    CHECK(parallel.normals == serial.normals);
+    CHECK(parallel.positionIndexes == serial.positionIndexes);
+    CHECK(parallel.textureIndexes == serial.textureIndexes);
+    CHECK(parallel.normalIndexes == serial.normalIndexes);
+
+    // The errors give the line in the whole file
+    std::string wrong = text + "f 1 2 3 zero\n";
+    std::size_t lines = std::count(wrong.begin(), wrong.end(), '\n');
+    std::string message;
+    try
+    {
+        ObjParser::parse(wrong, 4);
+    }
+    catch (const Exception::Loader::ParseError& error)
+    {
+        message = error.what();
+    }
+
+    CHECK(message == "[LOADER] Can't parse the file. -- Wrong index (line " + std::to_string(lines) + ").");
+}
@@ -0,0 +1,120 @@
+#include <Objects/Model.h>
+#include <Utils/Math.h>
+#include <doctest.h>
+
+#include <cmath>
+#include <memory>
+#include <optional>
+
+TEST_CASE("Testing model object")
+{
+    // Cube of size 10 centered on (0, 0, 10)
+    Vector3 coordinates(0, 0, 10);
+    Vector3 angle(0, 0, 0);
+    Model model(Materials::metal(), Colors::white(), "res/Object/cube.obj", coordinates, angle, 1);
+
+    CHECK(model.getBoundingBox().min() == Vector3(-5, -5, 5));
+    CHECK(model.getBoundingBox().max() == Vector3(5, 5, 15));
+    CHECK(model.getTriangleCount() == 12);
+
+    // Front face
+    Ray r1(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY);
+    CHECK(Matrix::areApproximatelyEqual(model.getIntersection(r1).value(), Vector3(0, 0, 5)));
+
+    // Back face (from the other side)
+    Ray r2(Vector3(1, 2, 30), Vector3(0, 0, -1), PRIMARY);
+    CHECK(Matrix::areApproximatelyEqual(model.getIntersection(r2).value(), Vector3(1, 2, 15)));
+
+    // Side face
+    Ray r3(Vector3(-20, 1, 10), Vector3(1, 0, 0), PRIMARY);
+    CHECK(Matrix::areApproximatelyEqual(model.getIntersection(r3).value(), Vector3(-5, 1, 10)));
+
+    // Miss
+    Ray r4(Vector3(0, 0, 0), Vector3(0, 1, 0), PRIMARY);
+    CHECK(model.getIntersection(r4) == std::nullopt);
+
+    Ray r5(Vector3(0, 0, 0), Vector3(0, 0, -1), PRIMARY);
+    CHECK(model.getIntersection(r5) == std::nullopt);
+
+    // The hit record gives the hit triangle, no need to search it again for the normal
+    auto hit = model.getHit(r3);
+    CHECK(hit.has_value());
+    CHECK(hit->t == 15);
+    CHECK(hit->primitive < 12);
+    CHECK(hit->normal == model.getNormal(hit->point));
+    CHECK(hit->normal.x() < 0);
+
+    // Everything is culled before the front face
+    Ray r6(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY, 0, 4.5);
+    CHECK(!model.getHit(r6).has_value());
+}
+
+TEST_CASE("Testing model cache")
+{
+    Vector3 coordinates(1, -2, 10);
+    Vector3 angle(0.3, 0.2, 0.1);
+    Ray ray(Vector3(1, -2, 0), Vector3(0, 0, 1), PRIMARY);
+
+    std::weak_ptr<const Mesh> mesh;
+    std::optional<HitRecord> hit;
+    std::size_t nodeCount = 0;
+    {
+        Model model(Materials::metal(), Colors::white(), "res/Object/cube.obj", coordinates, angle, 0.5);
+        mesh = model.getMesh();
+        hit = model.getHit(ray);
+        nodeCount = model.getBVH().getNodes().size();
+    }
+
+    // The mesh is freed with its last model, the second model is read from the cache file written by the first one
+    CHECK(mesh.expired());
+
+    Model cached(Materials::metal(), Colors::white(), "res/Object/cube.obj", coordinates, angle, 0.5);
+
+    CHECK(cached.getTriangleCount() == 12);
+    CHECK(cached.getBVH().getNodes().size() == nodeCount);
+    CHECK(cached.getHit(ray)->point == hit->point);
+    CHECK(cached.getHit(ray)->normal == hit->normal);
+}
+
+TEST_CASE("Testing model instancing")
+{
+    // The models using the same file share the mesh, only the transform is different
+    Model model(Materials::metal(), Colors::white(), "res/Object/cube.obj", Vector3(0, 0, 10), Vector3(0, 0, 0), 1);
+    Model other(Materials::transparent(),
+                Colors::red(),
+                "res/Object/cube.obj",
+                Vector3(20, 0, 10),
+                Vector3(0, M_PI / 4, 0),
+                2);
+
+    CHECK(model.getMesh() == other.getMesh());
+    CHECK(model.getMesh()->getBoundingBox().min() == Vector3(-5, -5, -5));
+
+    // Cube of size 20 centered on (20, 0, 10), rotated by 45 degrees around y: an edge toward -z
+    // (d is the half diagonal of a face)
+    double d = 10 * M_SQRT2;
+    CHECK(Matrix::areApproximatelyEqual(other.getBoundingBox().min(), Vector3(20 - d, -10, 10 - d)));
+    CHECK(Matrix::areApproximatelyEqual(other.getBoundingBox().max(), Vector3(20 + d, 10, 10 + d)));
+
+    Ray ray(Vector3(21, 1, -20), Vector3(0, 0, 2), PRIMARY);
+    auto hit = other.getHit(ray);
+    REQUIRE(hit.has_value());
+    CHECK(areDoubleApproximatelyEqual(hit->t, (31 - d) / 2, 0.0000001));
+    CHECK(Matrix::areApproximatelyEqual(hit->point, Vector3(21, 1, 11 - d), 0.0000001));
+
+    // The normal of a face of the rotated cube (unit vector)
+    CHECK(areDoubleApproximatelyEqual(Matrix::getNorm(hit->normal), 1, 0.0000001));
+    CHECK(areDoubleApproximatelyEqual(std::abs(hit->normal.x()), M_SQRT1_2, 0.0000001));
+    CHECK(hit->normal.z() < 0);
+    CHECK(Matrix::areApproximatelyEqual(other.getNormal(hit->point), hit->normal, 0.0000001));
+
+    // An instance of a mesh with its own transform
+    Transform transform({0, 0, 1, 0, 0, 1, 0, 0, -1, 0, 0, 50, 0, 0, 0, 1});
+    Model instance(Materials::metal(), Colors::white(), model.getMesh(), transform * model.getTransform());
+
+    CHECK(instance.getMesh() == model.getMesh());
+    CHECK(Matrix::areApproximatelyEqual(instance.getBoundingBox().min(), Vector3(5, -5, 45)));
+    CHECK(Matrix::areApproximatelyEqual(instance.getBoundingBox().max(), Vector3(15, 5, 55)));
+    CHECK(Matrix::areApproximatelyEqual(
+            instance.getIntersection(Ray(Vector3(10, 0, 0), Vector3(0, 0, 1), PRIMARY)).value(), Vector3(10, 0, 45)));
+}
@@ -29,14 +29,14 @@ TEST_CASE("Testing plane object")
     Vector3 light({{5, 5, 5}});
 
     // 6 Rays to test the result of getSecondaryRay
-    Ray s1(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()).toVector3(), SECONDARY);
-    Ray s1prime(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()).toVector3(), PRIMARY);
+    Ray s1(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()), SECONDARY);
+    Ray s1prime(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()), PRIMARY);
 
-    Ray s2(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light).toVector3(), SECONDARY);
-    Ray s2prime(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light).toVector3(), PRIMARY);
+    Ray s2(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light), SECONDARY);
+    Ray s2prime(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light), PRIMARY);
 
-    Ray s3(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()).toVector3(), SECONDARY);
-    Ray s3prime(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light).toVector3(), SECONDARY);
+    Ray s3(plane.getIntersection(r1).value(), (light - plane.getIntersection(r1).value()), SECONDARY);
+    Ray s3prime(plane.getIntersection(r1).value(), (plane.getIntersection(r1).value() - light), SECONDARY);
 
     // Test if there is an intersection point found
     CHECK(plane.getSecondaryRay(plane.getIntersection(r1).value(), light) == s1);
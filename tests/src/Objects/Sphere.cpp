@@ -41,15 +41,15 @@ TEST_CASE("testing sphere")
     Vector3 light({{5, 5, 5}});
 
     // 6 Rays to test the result of getSecondaryRay
-    Ray s1(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()).toVector3(), SECONDARY);
-    Ray s1prime(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()).toVector3(), PRIMARY);
+    Ray s1(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()), SECONDARY);
+    Ray s1prime(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()), PRIMARY);
 
-    Ray s2(sphere.getIntersection(r1).value(), (sphere.getIntersection(r1).value() - light).toVector3(), SECONDARY);
-    Ray s2prime(sphere.getIntersection(r1).value(), (sphere.getIntersection(r1).value() - light).toVector3(), PRIMARY);
+    Ray s2(sphere.getIntersection(r1).value(), (sphere.getIntersection(r1).value() - light), SECONDARY);
+    Ray s2prime(sphere.getIntersection(r1).value(), (sphere.getIntersection(r1).value() - light), PRIMARY);
 
-    Ray s3(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()).toVector3(), SECONDARY);
+    Ray s3(sphere.getIntersection(r1).value(), (light - sphere.getIntersection(r1).value()), SECONDARY);
     Ray s3prime(sphere.getIntersection(r1).value(),
-                (sphere.getIntersection(r1).value() - light).toVector3(),
+                (sphere.getIntersection(r1).value() - light),
                 SECONDARY);
 
     // Test if there is an intersection point found
@@ -63,4 +63,31 @@ TEST_CASE("testing sphere")
     CHECK(Matrix::areApproximatelyEqual(sphere.getNormal(sphere.getIntersection(r1).value()), (res1 - coordinates)));
     CHECK(Matrix::areApproximatelyEqual(sphere.getNormal(sphere.getIntersection(r2).value()), (res2 - coordinates)));
     CHECK(Matrix::areApproximatelyEqual(sphere.getNormal(sphere.getIntersection(r5).value()), (res5 - coordinates)));
-}
\ No newline at end of file
+}
+TEST_CASE("testing sphere hit record")
+{
+    Sphere sphere(Materials::metal(), Colors::white(), Vector3(0, 0, 10), 2);
+
+    Ray ray(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY);
+    auto hit = sphere.getHit(ray);
+
+    CHECK(hit.has_value());
+    CHECK(hit->t == 8);
+    CHECK(hit->point == Vector3(0, 0, 8));
+    CHECK(hit->normal == sphere.getNormal(hit->point));
+
+    // The ray interval culls the hits
+    ray.setTMax(7.5);
+    CHECK(!sphere.getHit(ray).has_value());
+
+    ray.setTMax(8);
+    CHECK(sphere.getHit(ray).has_value());
+
+    Ray inside(Vector3(0, 0, 10), Vector3(0, 0, 1), PRIMARY, 1.0, 3.0);
+    CHECK(inside.isInInterval(2));
+    CHECK(!inside.isInInterval(0.5));
+    CHECK(sphere.getHit(inside)->point == Vector3(0, 0, 12));
+
+    inside.setTMin(2.5);
+    CHECK(!sphere.getHit(inside).has_value());
+}
@@ -1,4 +1,5 @@
 #include <Objects/Triangle.h>
+#include <Utils/Math.h>
 #include <doctest.h>
 
 TEST_CASE("Testing triangle object")
@@ -60,19 +61,19 @@ TEST_CASE("Testing triangle object")
     Vector3 light({{5, 5, 5}});
 
     // 6 Rays to test the result of getSecondaryRay
-    Ray s1(triangle.getIntersection(r1).value(), (light - triangle.getIntersection(r1).value()).toVector3(), SECONDARY);
+    Ray s1(triangle.getIntersection(r1).value(), (light - triangle.getIntersection(r1).value()), SECONDARY);
     Ray s1prime(triangle.getIntersection(r1).value(),
-                (light - triangle.getIntersection(r1).value()).toVector3(),
+                (light - triangle.getIntersection(r1).value()),
                 PRIMARY);
 
-    Ray s2(triangle.getIntersection(r1).value(), (triangle.getIntersection(r1).value() - light).toVector3(), SECONDARY);
+    Ray s2(triangle.getIntersection(r1).value(), (triangle.getIntersection(r1).value() - light), SECONDARY);
     Ray s2prime(triangle.getIntersection(r1).value(),
-                (triangle.getIntersection(r1).value() - light).toVector3(),
+                (triangle.getIntersection(r1).value() - light),
                 PRIMARY);
 
-    Ray s3(triangle.getIntersection(r1).value(), (light - triangle.getIntersection(r1).value()).toVector3(), SECONDARY);
+    Ray s3(triangle.getIntersection(r1).value(), (light - triangle.getIntersection(r1).value()), SECONDARY);
     Ray s3prime(triangle.getIntersection(r1).value(),
-                (triangle.getIntersection(r1).value() - light).toVector3(),
+                (triangle.getIntersection(r1).value() - light),
                 SECONDARY);
 
     // Test if there is an intersection point found
@@ -94,3 +95,58 @@ TEST_CASE("Testing triangle object")
     CHECK(triangle.getNormal(triangle.getIntersection(r4).value()) == normal);
     CHECK(triangle.getNormal(triangle.getIntersection(r5).value()) == normal);
 }
+
+TEST_CASE("Testing triangle hit record")
+{
+    Triangle triangle(Materials::metal(), Colors::white(), Vector3(0, 0, 5), Vector3(4, 0, 5), Vector3(0, 4, 5));
+
+    Ray ray(Vector3(1, 2, 0), Vector3(0, 0, 1), PRIMARY);
+    auto hit = triangle.getHit(ray);
+
+    CHECK(hit.has_value());
+    CHECK(hit->t == 5);
+    CHECK(hit->normal == triangle.getNormal(hit->point));
+
+    // point = (1 - u - v) * A + u * B + v * C
+    CHECK(areDoubleApproximatelyEqual(hit->u, 0.25));
+    CHECK(areDoubleApproximatelyEqual(hit->v, 0.5));
+
+    ray.setTMax(4);
+    CHECK(!triangle.getHit(ray).has_value());
+}
+
+TEST_CASE("Testing triangle intersection kernel")
+{
+    Vector3 a(0, 0, 5);
+    Vector3 b(4, 0, 5);
+    Vector3 c(0, 4, 5);
+    Triangle triangle(Materials::metal(), Colors::white(), a, b, c);
+
+    // Same answer as the point in triangle test, away from the edges
+    for (int x = -5; x <= 45; x++)
+    {
+        for (int y = -5; y <= 45; y++)
+        {
+            Vector3 point(x * 0.1 + 0.03, y * 0.1 + 0.03, 5);
+            Ray ray(Vector3(0.5, 0.5, -3), point - Vector3(0.5, 0.5, -3), PRIMARY);
+
+            auto hit = Triangle::intersect(ray, a, b - a, c - a);
+            CHECK(hit.has_value() == triangle.isInTriangle(point));
+
+            if (hit.has_value())
+                CHECK(Matrix::areApproximatelyEqual(a + (b - a) * hit->u + (c - a) * hit->v, point, 0.0000001));
+        }
+    }
+
+    // Parallel ray
+    Ray parallel(Vector3(0, 0, 0), Vector3(1, 1, 0), PRIMARY);
+    CHECK(!Triangle::intersect(parallel, a, b - a, c - a).has_value());
+
+    // Behind the origin
+    Ray behind(Vector3(1, 1, 10), Vector3(0, 0, 1), PRIMARY);
+    CHECK(!triangle.getHit(behind).has_value());
+
+    // Back side
+    Ray back(Vector3(1, 1, 10), Vector3(0, 0, -1), PRIMARY);
+    CHECK(triangle.getHit(back)->point == Vector3(1, 1, 5));
+}
@@ -0,0 +1,94 @@
+#include <Samplers/Sampler.h>
+#include <Utils/Exceptions.h>
+#include <doctest.h>
+
+#include <set>
+#include <utility>
+
+namespace
+{
+    std::vector<Sample> generate(const Sampler& sampler, std::uint64_t pixel)
+    {
+        std::vector<Sample> samples(sampler.getSampleCount());
+        sampler.generate(pixel, samples.data());
+
+        return samples;
+    }
+
+    /**
+     * @brief Get the number of cells of a grid containing at least one sample.
+     */
+    std::size_t countFilledCells(const std::vector<Sample>& samples, std::size_t columns, std::size_t rows)
+    {
+        std::set<std::pair<std::size_t, std::size_t>> cells;
+        for (const auto& sample : samples)
+            cells.emplace(static_cast<std::size_t>(sample.x * columns), static_cast<std::size_t>(sample.y * rows));
+
+        return cells.size();
+    }
+} // namespace
+
+TEST_CASE("Testing sampler")
+{
+    CHECK_THROWS_AS(Sampler(0, Sampler::Pattern::STRATIFIED), Exception::Sampler::NoSample);
+
+    // Exactly the asked number of samples, in the pixel
+    for (auto pattern : {Sampler::Pattern::STRATIFIED,
+                         Sampler::Pattern::JITTERED,
+                         Sampler::Pattern::HALTON,
+                         Sampler::Pattern::SOBOL})
+    {
+        for (std::size_t sampleCount : {1, 2, 3, 4, 5, 8, 9, 16, 33})
+        {
+            Sampler sampler(sampleCount, pattern, 42);
+            CHECK(sampler.getSampleCount() == sampleCount);
+
+            for (std::uint64_t pixel = 0; pixel < 8; pixel++)
+            {
+                auto samples = generate(sampler, pixel);
+                for (const auto& sample : samples)
+                {
+                    CHECK((sample.x >= 0 && sample.x < 1));
+                    CHECK((sample.y >= 0 && sample.y < 1));
+                }
+
+                // Same samples for the same pixel and seed
+                auto again = generate(sampler, pixel);
+                for (std::size_t i = 0; i < sampleCount; i++)
+                {
+                    CHECK(samples[i].x == again[i].x);
+                    CHECK(samples[i].y == again[i].y);
+                }
+            }
+        }
+    }
+
+    // One sample is the center of the pixel
+    auto center = generate(Sampler(1, Sampler::Pattern::STRATIFIED), 7);
+    CHECK(center[0].x == 0.5);
+    CHECK(center[0].y == 0.5);
+
+    // Regular grid
+    auto grid = generate(Sampler(4, Sampler::Pattern::STRATIFIED), 0);
+    CHECK(grid[0].x == 0.25);
+    CHECK(grid[0].y == 0.25);
+    CHECK(grid[3].x == 0.75);
+    CHECK(grid[3].y == 0.75);
+
+    // One sample per cell, even with a random position
+    for (std::uint64_t pixel = 0; pixel < 16; pixel++)
+    {
+        CHECK(countFilledCells(generate(Sampler(16, Sampler::Pattern::JITTERED, 3), pixel), 4, 4) == 16);
+        CHECK(countFilledCells(generate(Sampler(16, Sampler::Pattern::SOBOL, 3), pixel), 4, 4) == 16);
+        CHECK(countFilledCells(generate(Sampler(16, Sampler::Pattern::SOBOL, 3), pixel), 16, 1) == 16);
+        CHECK(countFilledCells(generate(Sampler(16, Sampler::Pattern::SOBOL, 3), pixel), 1, 16) == 16);
+
+        // 2 rows of 4 cells
+        CHECK(countFilledCells(generate(Sampler(8, Sampler::Pattern::JITTERED, 3), pixel), 4, 2) == 8);
+    }
+
+    // The random patterns change with the pixel
+    auto first = generate(Sampler(4, Sampler::Pattern::HALTON), 0);
+    auto second = generate(Sampler(4, Sampler::Pattern::HALTON), 1);
+    CHECK(first[0].x != second[0].x);
+}
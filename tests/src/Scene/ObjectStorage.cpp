@@ -0,0 +1,58 @@
+#include <Scene/ObjectStorage.h>
+#include <doctest.h>
+
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("Testing object storage")
+{
+    ObjectStorage objects;
+
+    ObjectId sphere = objects.add<Sphere>(Materials::metal(), Colors::blue(), Vector3(0, 0, 10), 2);
+    ObjectId plane = objects.add<Plane>(Materials::metal(), Colors::green(), Vector3(0, -5, 0), Vector3(0, 1, 0));
+    ObjectId other = objects.add<Sphere>(Materials::metal(), Colors::red(), Vector3(0, 0, 20), 1);
+    ObjectId triangle = objects.add<Triangle>(
+            Materials::metal(), Colors::white(), Vector3(-1, -1, 5), Vector3(1, -1, 5), Vector3(0, 1, 5));
+
+    // One array per type, the ids are the indexes in the arrays
+    CHECK(sphere.type == ObjectId::Type::SPHERE);
+    CHECK(sphere.index == 0);
+    CHECK(other.type == ObjectId::Type::SPHERE);
+    CHECK(other.index == 1);
+    CHECK(plane.type == ObjectId::Type::PLANE);
+    CHECK(plane.index == 0);
+    CHECK(triangle.type == ObjectId::Type::TRIANGLE);
+    CHECK(sphere != other);
+    CHECK(sphere == ObjectId{ObjectId::Type::SPHERE, 0});
+
+    CHECK(objects.size() == 4);
+    CHECK(objects.getObjects<Sphere>().size() == 2);
+    CHECK(objects.getObjects<Model>().empty());
+    CHECK(objects.get(other).getColor().red() == Colors::red().red());
+    CHECK(objects.get(other).getColor().green() == 0);
+    CHECK(objects.get(plane).getColor().green() == Colors::green().green());
+    CHECK(objects.get(plane).getColor().red() == 0);
+
+    // The objects are visited as their real type
+    CHECK(objects.visit(sphere, [](const auto& object) {
+        return std::is_same_v<std::decay_t<decltype(object)>, Sphere>;
+    }));
+    CHECK(objects.visit(triangle, [](const auto& object) {
+        return std::is_same_v<std::decay_t<decltype(object)>, Triangle>;
+    }));
+
+    Ray ray(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY);
+    auto hit = objects.visit(other, [&](const auto& object) { return object.getHit(ray); });
+    REQUIRE(hit.has_value());
+    CHECK(hit->t == 19);
+
+    std::vector<ObjectId> ids;
+    objects.forEach([&](ObjectId id, const Object& object) {
+        CHECK(&object == &objects.get(id));
+        ids.push_back(id);
+    });
+    CHECK(ids == std::vector<ObjectId>{sphere, other, plane, triangle});
+
+    objects.clear();
+    CHECK(objects.size() == 0);
+}
@@ -1,8 +1,24 @@
 #include <Light/Punctual.h>
+#include <Objects/Model.h>
+#include <Objects/Plane.h>
 #include <Objects/Sphere.h>
 #include <Scene/Scene.h>
 #include <doctest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+} // namespace
+
 TEST_CASE("Testing scene")
 {
     Scene scene(Scene::camera(Vector3(0, 0, 0), Vector3(0, 0, 1), Size(256, 144), 1));
@@ -18,4 +34,92 @@ TEST_CASE("Testing scene")
 
     // Generate output
     CHECK_NOTHROW(scene.generate("out.png"));
-}
\ No newline at end of file
+
+    // One primary ray per pixel, and one shadow ray per visible point (only one light)
+    const auto& statistics = scene.getRenderStatistics();
+    CHECK(statistics.primaryRayCount == 256 * 144);
+    CHECK(statistics.shadowRayCount > 0);
+    CHECK(statistics.shadowRayCount <= statistics.primaryRayCount + statistics.reflectionRayCount);
+    CHECK(statistics.refractionRayCount == 0);
+    CHECK(statistics.getRayCount() ==
+          statistics.primaryRayCount + statistics.shadowRayCount + statistics.reflectionRayCount);
+    CHECK(statistics.threadCount == scene.getThreadCount());
+
+    // With anti-aliasing
+    scene.enableAntialiasing(4, Sampler::Pattern::JITTERED);
+    CHECK_NOTHROW(scene.generate("out.png"));
+    CHECK(scene.getRenderStatistics().primaryRayCount == 4 * 256 * 144);
+
+    scene.enableAntialiasing(8, Sampler::Pattern::SOBOL, true);
+    CHECK_NOTHROW(scene.generate("out.png"));
+
+    scene.disableAntialiasing();
+}
+
+TEST_CASE("Testing scene packet tracing")
+{
+    Scene scene(Scene::camera(Vector3(0, 0, 0), Vector3(0, 0, 1), Size(203, 117), 1));
+
+    scene.addLight<Punctual>(10, Colors::white(), Vector3(5, 0, 10));
+    scene.addObject<Sphere>(Materials::metal(), Colors::blue(), Vector3(0, 4, 15), 3);
+    scene.addObject<Sphere>(Materials::metal(), Colors::white(), Vector3(0, 4, 8), 1);
+    scene.addObject<Sphere>(Materials::metal(), Colors::red(), Vector3(0, -4, 20), 2);
+    scene.addObject<Plane>(Materials::metal(), Colors::green(), Vector3(0, -6, 0), Vector3(0, 1, 0));
+    scene.addObject<Model>(
+            Materials::metal(), Colors::white(), "res/Object/cube.obj", Vector3(6, 0, 25), Vector3(0.3, 0.5, 0), 0.4);
+
+    // The packets give the same image as the rays traced one by one (partial tiles and blocks included)
+    auto checkSameImage = [&]() {
+        scene.setPacketTracing(true);
+        scene.generate("test_packets.ppm");
+        auto packetStatistics = scene.getRenderStatistics();
+
+        scene.setPacketTracing(false);
+        scene.generate("test_rays.ppm");
+
+        CHECK(readFile("test_packets.ppm") == readFile("test_rays.ppm"));
+        CHECK(packetStatistics.getRayCount() == scene.getRenderStatistics().getRayCount());
+
+        std::remove("test_packets.ppm");
+        std::remove("test_rays.ppm");
+    };
+
+    checkSameImage();
+
+    scene.enableAntialiasing(4, Sampler::Pattern::JITTERED);
+    checkSameImage();
+
+    scene.enableAntialiasing(8, Sampler::Pattern::SOBOL, true);
+    checkSameImage();
+}
+
+TEST_CASE("Testing scene sphere batch")
+{
+    Scene scene(Scene::camera(Vector3(0, 0, 0), Vector3(0, 0, 1), Size(160, 90), 1));
+
+    scene.addLight<Punctual>(10, Colors::white(), Vector3(5, 8, 10));
+    scene.addObject<Plane>(Materials::metal(), Colors::green(), Vector3(0, -6, 0), Vector3(0, 1, 0));
+
+    // Small spheres close to each other, the BVH leaves have enough of them for the sphere batch
+    for (int x = -4; x <= 4; x++)
+    {
+        for (int y = -2; y <= 2; y++)
+        {
+            for (int z = 0; z < 3; z++)
+                scene.addObject<Sphere>(
+                        Materials::metal(), Colors::red(), Vector3(x * 1.5, y * 1.5, 20 + z * 1.5), 0.5 + 0.05 * z);
+        }
+    }
+
+    // The single rays (sphere batch) give the same image as the packets (one sphere at a time)
+    scene.setPacketTracing(true);
+    scene.generate("test_packets.ppm");
+
+    scene.setPacketTracing(false);
+    scene.generate("test_rays.ppm");
+
+    CHECK(readFile("test_packets.ppm") == readFile("test_rays.ppm"));
+
+    std::remove("test_packets.ppm");
+    std::remove("test_rays.ppm");
+}
@@ -0,0 +1,70 @@
+#include <Utils/Framebuffer.h>
+#include <doctest.h>
+
+namespace
+{
+    bool areSameColors(const Color& a, const Color& b)
+    {
+        return a.red() == b.red() && a.green() == b.green() && a.blue() == b.blue();
+    }
+
+#ifdef SFML_VIEWER
+    bool areSameColors(const sf::Color& a, const sf::Color& b)
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b;
+    }
+#endif
+} // namespace
+
+TEST_CASE("Testing radiance")
+{
+    // No clamp during the computations
+    Radiance bright = Radiance(Colors::white()) * 3 + Radiance(0.5f, 0, 0);
+    CHECK(bright == Radiance(3.5f, 3, 3));
+    CHECK((bright * 0.5) == Radiance(1.75f, 1.5f, 1.5f));
+    CHECK((Radiance(-1, 0, 0) + Radiance(1.5f, 0, 0)).red() == 0.5f);
+
+    // Only when quantized
+    CHECK(areSameColors(bright.toColor(), Colors::white()));
+    CHECK(areSameColors(Radiance(-1, 2, 0.5f).toColor(), Color(0, 255, 128)));
+
+    // A color doesn't change through a radiance
+    for (int channel = 0; channel <= 255; channel++)
+    {
+        Color color(static_cast<uint8_t>(channel), 0, static_cast<uint8_t>(255 - channel));
+        CHECK(areSameColors(Radiance(color).toColor(), color));
+    }
+}
+
+TEST_CASE("Testing framebuffer")
+{
+    Framebuffer framebuffer(3, 2);
+
+    CHECK(framebuffer.width() == 3);
+    CHECK(framebuffer.height() == 2);
+    CHECK(framebuffer.getPixel(2, 1) == Radiance());
+
+    framebuffer.setPixel(2, 1, Radiance(1, 0.5f, 2));
+    framebuffer.getRow(0)[1] = Radiance(0, 1, 0);
+
+    CHECK(framebuffer.getPixel(2, 1) == Radiance(1, 0.5f, 2));
+    CHECK(framebuffer.getPixel(1, 0) == Radiance(0, 1, 0));
+
+    std::vector<std::uint8_t> pixels = framebuffer.toRGB();
+    CHECK(pixels.size() == 3 * 2 * 3);
+    CHECK(pixels[3 * 3 + 6] == 255);
+    CHECK(pixels[3 * 3 + 7] == 128);
+    CHECK(pixels[3 * 3 + 8] == 255);
+    CHECK(pixels[3] == 0);
+    CHECK(pixels[4] == 255);
+    CHECK(pixels[0] == 0);
+
+#ifdef SFML_VIEWER
+    sf::Image image = framebuffer.toImage();
+    CHECK(image.getSize().x == 3);
+    CHECK(image.getSize().y == 2);
+    CHECK(areSameColors(image.getPixel(2, 1), sf::Color(255, 128, 255)));
+    CHECK(areSameColors(image.getPixel(1, 0), sf::Color(0, 255, 0)));
+    CHECK(areSameColors(image.getPixel(0, 0), sf::Color(0, 0, 0)));
+#endif
+}
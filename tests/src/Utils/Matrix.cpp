@@ -11,6 +11,11 @@ TEST_CASE("testing matrix 1")
     CHECK(a.value(0, 1) == 0);
     CHECK(a.value(1, 0) == 0);
     CHECK(a.value(1, 1) == 1);
+    CHECK(a.uncheckedValue(1, 0) == 0);
+
+    // Checked in release too
+    CHECK_THROWS_AS(a.value(2, 0), Exception::Matrix::WrongCoordinates);
+    CHECK_THROWS_AS(a.value(0, 2), Exception::Matrix::WrongCoordinates);
 
     Matrix b(2, 2, {{0, 1}, {1, 0}});
     Matrix b2(2, 2, {{-3, -2}, {-2, 6}});
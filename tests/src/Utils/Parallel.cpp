@@ -0,0 +1,76 @@
+#include <Utils/Parallel.h>
+#include <doctest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Testing parallel for")
+{
+    CHECK(resolveThreadCount(0) >= 1);
+    CHECK(resolveThreadCount(3) == 3);
+
+    // Every index is visited exactly once
+    for (std::size_t threadCount : {0, 1, 2, 7})
+    {
+        std::vector<std::atomic<int>> visits(1000);
+        parallelFor(visits.size(), threadCount, [&](std::size_t index) { visits[index]++; });
+
+        bool once = true;
+        for (const auto& visit : visits)
+            once = once && visit == 1;
+
+        CHECK(once);
+    }
+
+    // Nothing to do
+    std::atomic<int> calls = 0;
+    parallelFor(0, 4, [&](std::size_t) { calls++; });
+    CHECK(calls == 0);
+
+    // The exception is given back to the caller
+    CHECK_THROWS_AS(parallelFor(100,
+                                4,
+                                [](std::size_t index) {
+                                    if (index == 42)
+                                        throw std::runtime_error("error");
+                                }),
+                    std::runtime_error);
+}
+
+TEST_CASE("Testing parallel for with work stealing")
+{
+    // Every index is visited exactly once, with a valid thread index
+    for (std::size_t threadCount : {0, 1, 2, 7})
+    {
+        std::vector<std::atomic<int>> visits(1000);
+        std::atomic<bool> validThreads = true;
+
+        parallelForWorkStealing(visits.size(), threadCount, [&](std::size_t index, std::size_t thread) {
+            // Uneven cost, the last indexes are the most expensive
+            volatile double sum = 0;
+            for (std::size_t i = 0; i < index * 10; i++)
+                sum = sum + static_cast<double>(i);
+
+            visits[index]++;
+            if (thread >= resolveThreadCount(threadCount))
+                validThreads = false;
+        });
+
+        bool once = true;
+        for (const auto& visit : visits)
+            once = once && visit == 1;
+
+        CHECK(once);
+        CHECK(validThreads);
+    }
+
+    // The exception is given back to the caller
+    CHECK_THROWS_AS(parallelForWorkStealing(100,
+                                            4,
+                                            [](std::size_t index, std::size_t) {
+                                                if (index == 42)
+                                                    throw std::runtime_error("error");
+                                            }),
+                    std::runtime_error);
+}
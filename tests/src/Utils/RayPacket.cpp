@@ -0,0 +1,199 @@
+#include <Accelerators/BVH.h>
+#include <Objects/Model.h>
+#include <Objects/Plane.h>
+#include <Objects/Sphere.h>
+#include <Objects/Triangle.h>
+#include <Utils/Math.h>
+#include <Utils/RayPacket.h>
+#include <doctest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Rays from the same origin toward a grid of points (away from the edges of the tested objects).
+     */
+    std::vector<Ray> makeRays(const Vector3& origin, double z)
+    {
+        std::vector<Ray> rays;
+        for (int y = -16; y < 16; y++)
+        {
+            for (int x = -16; x < 16; x++)
+                rays.emplace_back(origin, Vector3(x * 0.7 + 0.03, y * 0.7 + 0.07, z) - origin, PRIMARY);
+        }
+
+        return rays;
+    }
+
+    /**
+     * @brief Check that the packet intersection of an object gives the same hits as its ray by ray intersection.
+     */
+    void checkPacketHits(const Object& object, const std::vector<Ray>& rays)
+    {
+        for (std::size_t begin = 0; begin < rays.size(); begin += RayPacket::SIZE)
+        {
+            RayPacket packet;
+            for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+                packet.setRay(lane, rays[begin + lane]);
+
+            RayPacket::Mask hits = object.getHits(packet, RayPacket::firstLanes(RayPacket::SIZE));
+
+            for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+            {
+                auto expected = object.getHit(rays[begin + lane]);
+
+                REQUIRE(static_cast<bool>(hits >> lane & 1) == expected.has_value());
+                if (!expected.has_value())
+                {
+                    CHECK(packet.tMax[lane] == std::numeric_limits<double>::infinity());
+                    continue;
+                }
+
+                const HitRecord& hit = packet.hits[lane];
+                CHECK(areDoubleApproximatelyEqual(hit.t, expected->t, 0.0000001));
+                CHECK(packet.tMax[lane] == hit.t);
+                CHECK(Matrix::areApproximatelyEqual(hit.point, expected->point, 0.0000001));
+                CHECK(Matrix::areApproximatelyEqual(hit.normal, expected->normal, 0.0000001));
+                CHECK(hit.primitive == expected->primitive);
+                CHECK(areDoubleApproximatelyEqual(hit.u, expected->u, 0.0000001));
+                CHECK(areDoubleApproximatelyEqual(hit.v, expected->v, 0.0000001));
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("Testing ray packet")
+{
+    CHECK(RayPacket::firstLanes(0) == 0);
+    CHECK(RayPacket::firstLanes(3) == 0b111);
+    CHECK(RayPacket::count(0b101100) == 3);
+    CHECK(RayPacket::first(0b101100) == 2);
+
+    Ray ray(Vector3(1, 2, 3), Vector3(0, 0.5, -2), PRIMARY, 0.5, 10);
+
+    RayPacket packet;
+    packet.setRay(5, ray);
+
+    CHECK(packet.getRay(5) == ray);
+    CHECK(packet.getRay(5).getTMin() == 0.5);
+    CHECK(packet.getRay(5).getTMax() == 10);
+    CHECK(packet.inverseDirectionX[5] == std::numeric_limits<double>::infinity());
+    CHECK(packet.inverseDirectionY[5] == 2);
+    CHECK(packet.inverseDirectionZ[5] == -0.5);
+
+    // Box test, only for the lanes of the mask and in [0, tMax]
+    BoundingBox box(Vector3(-1, -1, 5), Vector3(1, 1, 7));
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+        packet.setRay(lane, Ray(Vector3(lane * 0.4, 0, 0), Vector3(0, 0, 1), PRIMARY));
+
+    CHECK(box.intersect(packet, RayPacket::firstLanes(RayPacket::SIZE)) == 0b111);
+    CHECK(box.intersect(packet, 0b110) == 0b110);
+
+    packet.tMax[1] = 4;
+    CHECK(box.intersect(packet, RayPacket::firstLanes(RayPacket::SIZE)) == 0b101);
+}
+
+TEST_CASE("Testing packet hits")
+{
+    std::vector<Ray> rays = makeRays(Vector3(0.1, 0.2, -10), 10);
+
+    checkPacketHits(Sphere(Materials::metal(), Colors::white(), Vector3(1, -2, 10), 6), rays);
+    checkPacketHits(Sphere(Materials::metal(), Colors::white(), Vector3(0, 0, -10), 3), rays);
+    checkPacketHits(Plane(Materials::metal(), Colors::white(), Vector3(0, -3, 0), Vector3(0, 1, 0)), rays);
+    checkPacketHits(Plane(Materials::metal(), Colors::white(), Vector3(0, 0, 12), Vector3(0.2, 0, -1)), rays);
+
+    Triangle triangle(Materials::metal(), Colors::white(), Vector3(-5, -5, 8), Vector3(7, -4, 9), Vector3(0, 6, 7));
+    checkPacketHits(triangle, rays);
+
+    checkPacketHits(Model(Materials::metal(),
+                          Colors::white(),
+                          "res/Object/cube.obj",
+                          Vector3(0, 0, 10),
+                          Vector3(0.3, 0.5, 0),
+                          1),
+                    rays);
+
+    // Only the lanes of the mask are intersected, and nothing farther than their tMax
+    Sphere sphere(Materials::metal(), Colors::white(), Vector3(0, 0, 10), 2);
+
+    RayPacket packet;
+    for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+        packet.setRay(lane, Ray(Vector3(0, 0, 0), Vector3(0, 0, 1), PRIMARY));
+    packet.tMax[2] = 5;
+
+    CHECK(sphere.getHits(packet, 0b1110) == 0b1010);
+    CHECK(packet.tMax[0] == std::numeric_limits<double>::infinity());
+    CHECK(packet.tMax[1] == 8);
+    CHECK(packet.tMax[2] == 5);
+    CHECK(packet.hits[3].point == Vector3(0, 0, 8));
+
+    // A ray alone
+    CHECK(sphere.getHits(packet, 0b1) == 0b1);
+    CHECK(packet.tMax[0] == 8);
+    CHECK(sphere.getHits(packet, 0b1) == 0b1);
+    CHECK(sphere.getHits(packet, 0) == 0);
+}
+
+TEST_CASE("Testing BVH packet traversal")
+{
+    // Grid of spheres
+    std::vector<std::shared_ptr<Sphere>> spheres;
+    std::vector<BoundingBox> boxes;
+    for (int x = -5; x <= 5; x++)
+    {
+        for (int y = -5; y <= 5; y++)
+        {
+            spheres.push_back(std::make_shared<Sphere>(Materials::metal(),
+                                                       Colors::white(),
+                                                       Vector3(x * 3.0, y * 3.0, 10.0 + x + y),
+                                                       1.0));
+            boxes.push_back(spheres.back()->getBoundingBox());
+        }
+    }
+
+    BVH bvh;
+    bvh.build(boxes);
+
+    // The closest hit of each ray must be the one found by testing all the spheres
+    std::vector<Ray> rays = makeRays(Vector3(0, 0, -10), 20);
+    for (std::size_t begin = 0; begin < rays.size(); begin += RayPacket::SIZE)
+    {
+        RayPacket packet;
+        for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+            packet.setRay(lane, rays[begin + lane]);
+
+        // Every other ray, so that the packet is split
+        RayPacket::Mask mask = begin % (RayPacket::SIZE * 2) == 0 ? 0x5555 : 0xFFFF;
+
+        bvh.traverse(packet, mask, [&](std::size_t index, RayPacket::Mask lanes) {
+            CHECK((lanes & ~mask) == 0);
+            spheres[index]->getHits(packet, lanes);
+        });
+
+        for (std::size_t lane = 0; lane < RayPacket::SIZE; lane++)
+        {
+            double expected = std::numeric_limits<double>::infinity();
+            if (mask >> lane & 1)
+            {
+                for (const auto& sphere : spheres)
+                {
+                    auto hit = sphere->getHit(rays[begin + lane]);
+                    if (hit.has_value())
+                        expected = std::min(expected, hit->t);
+                }
+            }
+
+            if (expected == std::numeric_limits<double>::infinity())
+                CHECK(packet.tMax[lane] == expected);
+            else
+                CHECK(areDoubleApproximatelyEqual(packet.tMax[lane], expected, 0.0000001));
+        }
+    }
+
+    // Empty hierarchy
+    RayPacket packet;
+    BVH().traverse(packet, 0xFFFF, [&](std::size_t, RayPacket::Mask) { CHECK(false); });
+}
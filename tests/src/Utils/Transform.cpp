@@ -0,0 +1,49 @@
+#include <Utils/Exceptions.h>
+#include <Utils/Transform.h>
+#include <doctest.h>
+
+TEST_CASE("Testing transform")
+{
+    Transform identity;
+    CHECK(identity.transformPoint(Vector3(1, 2, 3)) == Vector3(1, 2, 3));
+    CHECK(identity.inverseTransformVector(Vector3(1, 2, 3)) == Vector3(1, 2, 3));
+
+    // Same placement as the vertices rotated by Vector3
+    Vector3 coordinates(1, -2, 10);
+    Vector3 angle(0.3, 0.2, 0.1);
+    Transform transform = Transform::placement(coordinates, angle, 2);
+
+    Vector3 point(1, 2, 3);
+    Vector3 expected = (point * 2).rotateX(angle.x()).rotateY(angle.y()).rotateZ(angle.z()) + coordinates;
+    CHECK(Matrix::areApproximatelyEqual(transform.transformPoint(point), expected, 0.0000001));
+    CHECK(Matrix::areApproximatelyEqual(transform.inverseTransformPoint(expected), point, 0.0000001));
+    CHECK(Matrix::areApproximatelyEqual(
+            transform.inverseTransformVector(transform.transformVector(point)), point, 0.0000001));
+
+    // The ray parameter is kept in the object space
+    Ray ray(Vector3(1, 2, 3), Vector3(0.5, -1, 2), PRIMARY, 1, 20);
+    Ray local = transform.inverseTransformRay(ray);
+    CHECK(local.getTMin() == 1);
+    CHECK(local.getTMax() == 20);
+    CHECK(Matrix::areApproximatelyEqual(transform.transformPoint(local.getDirection() * 7 + local.getOrigin()),
+                                        ray.getDirection() * 7 + ray.getOrigin(),
+                                        0.0000001));
+
+    // The normals stay orthogonal to the transformed surface
+    Transform stretch({2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
+    Vector3 tangent = stretch.transformVector(Vector3(1, -1, 0));
+    CHECK(Matrix::dot(stretch.transformNormal(Vector3(1, 1, 0)), tangent) == 0);
+
+    BoundingBox box = stretch.transformBox(BoundingBox(Vector3(-1, -1, -1), Vector3(1, 1, 1)));
+    CHECK(box.min() == Vector3(-2, -1, -1));
+    CHECK(box.max() == Vector3(2, 1, 1));
+
+    // Composition, the right transform is applied first
+    Transform translation({1, 0, 0, 5, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
+    CHECK((translation * stretch).transformPoint(Vector3(1, 1, 1)) == Vector3(7, 1, 1));
+    CHECK((stretch * translation).transformPoint(Vector3(1, 1, 1)) == Vector3(12, 1, 1));
+    CHECK((stretch * translation).inverseTransformPoint(Vector3(12, 1, 1)) == Vector3(1, 1, 1));
+
+    CHECK_THROWS_AS(Transform({1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}), Exception::Matrix::NotInvertible);
+    CHECK_THROWS_AS(Transform({1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 1}), Exception::Matrix::NotInvertible);
+}
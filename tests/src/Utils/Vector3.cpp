@@ -2,6 +2,7 @@
 #include <cmath>
 #include <doctest.h>
 #include <optional>
+#include <type_traits>
 
 TEST_CASE("testing vector3")
 {
@@ -20,7 +21,7 @@ TEST_CASE("testing vector3")
     CHECK(a.z() == 6);
 
     Vector3 b({2, 0, 0});
-    Vector3 c = b.normalize().toVector3();
+    Vector3 c = b.normalize();
 
     CHECK(c.x() == 1);
     CHECK(c.y() == 0);
@@ -49,22 +50,22 @@ TEST_CASE("testing vector3")
     // Vector3(1,3) * Vector3(1,3)
     CHECK_THROWS(b * c);
 
-    // Vector3(3,1) * Vector3(1,3)
-    CHECK_NOTHROW(b.transpose() * c);
+    // Matrix(3,1) * Vector3(1,3)
+    CHECK_NOTHROW(Matrix::transposed(b) * c);
 
     // Vector3 = Matrix(3,3)
-    CHECK_THROWS(d = b * c);
+    CHECK_THROWS(d = Matrix::transposed(b) * c);
 
     // Matrix(3,1) * Matrix(1,3) = (3,3)
-    CHECK_NOTHROW(b * c);
+    CHECK_NOTHROW(Matrix::transposed(b) * c);
 
     // Vector3 = Matrix(1,1)
-    CHECK_THROWS(d = c * b);
+    CHECK_THROWS(d = c * Matrix::transposed(b));
 
     b = Vector3({6, 0, 0});
 
     CHECK(b != c);
-    CHECK(b != m);
+    CHECK(Matrix(b) != m);
     CHECK(d == b);
 
     b = Vector3({1.256, 9.6899, 0.00025});
@@ -77,8 +78,71 @@ TEST_CASE("testing vector3")
     CHECK(res.value() == Vector3({1, 1, 1}));
 
     b = Vector3({6, 0, 0});
-    Vector3 v = b.transpose();
+    Vector3 v = Matrix::transposed(b);
     CHECK(v.x() == 6);
     CHECK(v.y() == 0);
     CHECK(v.z() == 0);
-}
\ No newline at end of file
+
+    // Value type, no allocation
+    CHECK(std::is_trivially_copyable_v<Vector3>);
+    CHECK(sizeof(Vector3) == 3 * sizeof(double));
+
+    Vector3 e(3, 4, 0);
+    CHECK(e.getNorm() == 5);
+    CHECK(e.distance(Vector3(0, 0, 0)) == 5);
+
+    e -= Vector3(3, 0, 0);
+    e *= 0.25;
+    CHECK(e == Vector3(0, 1, 0));
+
+    Vector3 f = e;
+    CHECK(f.rotateZ(M_PI / 2) == Vector3(-1, 0, 0));
+    CHECK(f.rotateY(M_PI / 2) == Vector3(0, 0, 1));
+    CHECK(f.rotateX(M_PI / 2) == Vector3(0, -1, 0));
+    CHECK(Matrix::areApproximatelyEqual(e.rotateX(0.3), Vector3(Matrix::rotationX(0.3, Vector3(0, 1, 0))), 0.0000001));
+
+    CHECK_THROWS(Vector3(Matrix(3, 3)));
+    CHECK_THROWS(Vector3({1, 2, 3, 4}));
+}
+
+TEST_CASE("testing vector3 fixed-dimension operations")
+{
+    Vector3 a(0.3, -1.2, 2.5);
+    Vector3 b(-0.7, 0.4, 1.1);
+
+    Matrix ma = a;
+    Matrix mb = b;
+
+    // Same results as the general matrix versions (up to the rounding, the operations aren't done in the same order)
+    const double precision = 0.0000001;
+    CHECK(areDoubleApproximatelyEqual(Matrix::dot(a, b), Matrix::dot(ma, mb), precision));
+    CHECK(areDoubleApproximatelyEqual(Matrix::getNorm(a), Matrix::getNorm(ma), precision));
+    CHECK(Matrix::areApproximatelyEqual(Matrix::normalize(a), Vector3(Matrix::normalize(Matrix(ma))), precision));
+    CHECK(Matrix::areApproximatelyEqual(Matrix::vectProduct(a, b), Vector3(Matrix::vectProduct(ma, mb)), precision));
+    CHECK(Matrix::areApproximatelyEqual(
+            Matrix::reflection(a, b), Vector3(Matrix::reflection(Matrix(ma), Matrix(mb))), precision));
+    CHECK(Matrix::areApproximatelyEqual(
+            Matrix::refraction(a, b, 1, 1.5), Vector3(Matrix::refraction(Matrix(ma), Matrix(mb), 1, 1.5)), precision));
+    CHECK(Matrix::areApproximatelyEqual(Matrix::refraction(a, b * -1, 1.5, 1),
+                                        Vector3(Matrix::refraction(Matrix(ma), Matrix(mb) * -1, 1.5, 1)),
+                                        precision));
+    CHECK_THROWS(Matrix::refraction(a, b, 0, 1));
+
+    // Total internal reflection: the direction is kept but normalized, like the matrix version (which normalizes its
+    // argument in place)
+    Vector3 grazing(2, 0, -0.1);
+    Vector3 normal(0, 0, 1);
+    Matrix matrixGrazing = grazing;
+    CHECK(Matrix::refraction(grazing, normal, 1.5, 1) == Matrix::normalize(grazing));
+    CHECK(Matrix::areApproximatelyEqual(
+            Vector3(Matrix::refraction(matrixGrazing, Matrix(normal), 1.5, 1)), Matrix::normalize(grazing), precision));
+    CHECK(Matrix::areApproximatelyEqual(Vector3(matrixGrazing), Matrix::normalize(grazing), precision));
+
+    CHECK(Matrix::areApproximatelyEqual(a, Vector3(0.3, -1.2, 2.5001)));
+    CHECK(!Matrix::areApproximatelyEqual(a, Vector3(0.3, -1.2, 2.5001), 0));
+    CHECK(Matrix::areApproximatelyEqual(a, a, 0));
+
+    // The vectors are not modified
+    CHECK(a == Vector3(0.3, -1.2, 2.5));
+    CHECK(b == Vector3(-0.7, 0.4, 1.1));
+}